@@ -0,0 +1,797 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Headless microbenchmarks for the world, meshing and chunk map hot paths.
+// Never opens a window, results go to stdout as CSV so runs can be diffed
+// between releases:
+//   benchmark,unit,ops,total_ms,ns_per_op,ops_per_sec
+// Pass a substring as the first argument to only run matching benchmarks.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "chunkMap.h"
+#include "chunkMeshGeneration.h"
+#include "chunkPool.h"
+#include "chunkStorage.h"
+#include "chunkVoxels.h"
+#include "heightmapCache.h"
+#include "jobSystem.h"
+#include "meshArena.h"
+#include "noise.h"
+#include "raycast.h"
+#include "regionFile.h"
+#include "settings.h"
+#include "timer.h"
+#include "voxelEdits.h"
+#include "world.h"
+#include "worldGeneration.h"
+
+// Each benchmark repeats its batch until it has run for at least this long
+#define BENCH_MIN_NANOSECONDS 250000000ull
+#define BENCH_MAP_KEY_RADIUS 10
+#define BENCH_WORLD_DISTANCE 6
+#define BENCH_RAY_COUNT 4096
+#define BENCH_RAY_LENGTH 64.0f
+#define BENCH_EDIT_BOX_SIZE 24
+#define BENCH_READ_BOX_SIZE 48
+#define BENCH_SAVE_DIRECTORY "VoxelX_bench_world" // Deleted afterwards
+#define BENCH_POOL_CHUNKS 4096
+
+static const int streamingDistances[] = {2, 4, 6, 8};
+
+static const char* benchFilter = NULL;
+
+// Keeps results alive so the compiler can't drop the measured work
+static volatile uintptr_t benchSink = 0;
+
+// Small deterministic generator, rand() differs between platforms
+static uint32_t randomState = 0x9E3779B9u;
+
+static float RandomFloat(const float min, const float max)
+{
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return min + (max - min) * (float)(randomState >> 8) / (float)(1 << 24);
+}
+
+static const char* meshBenchmarks[] = {"mesh_snapshot", "mesh_build_naive",
+                                       "mesh_build_greedy", "mesh_build_edit"};
+static const char* readBenchmarks[] = {"voxel_read_get", "voxel_read_region"};
+static const char* editBenchmarks[] = {"edit_place_voxel", "edit_fill_box"};
+static const char* storageBenchmarks[] = {
+  "storage_save_chunk", "storage_load_chunk", "stream_saved_load"};
+static const char* chunkMapBenchmarks[] = {
+  "chunk_map_put", "chunk_map_get_hit", "chunk_map_get_miss",
+  "chunk_map_remove", "chunk_map_iterate"};
+
+static bool ShouldRun(const char* name)
+{
+  return !benchFilter || strstr(name, benchFilter) != NULL;
+}
+
+static bool ShouldRunAny(const char** names, const int count)
+{
+  for (int i = 0; i < count; i++)
+  {
+    if (ShouldRun(names[i])) return true;
+  }
+  return false;
+}
+
+static void Report(const char* name, const char* unit, const long long ops,
+                   const uint64_t nanoseconds)
+{
+  const double seconds = (double)nanoseconds * 1e-9;
+  printf("%s,%s,%lld,%.3f,%.1f,%.0f\n", name, unit, ops, seconds * 1e3,
+         (double)nanoseconds / (double)ops, (double)ops / seconds);
+  fflush(stdout);
+}
+
+// Number of chunks LoadChunksAround keeps loaded for a draw distance
+static int CountChunksInSphere(const int distance)
+{
+  int count = 0;
+  for (int x = -distance; x <= distance; x++)
+    for (int y = -distance; y <= distance; y++)
+      for (int z = -distance; z <= distance; z++)
+        count += x * x + y * y + z * z <= distance * distance;
+  return count;
+}
+
+// Done once every chunk around center is loaded and meshed
+static bool IsStreamingSettled(const int expectedChunks)
+{
+  if (JobSystemPendingCount() > 0) return false;
+  if ((int)ChunkHashMapSize(loadedChunks) != expectedChunks) return false;
+
+  ChunkHashMapIterator it = ChunkHashMapIteratorCreate(loadedChunks);
+  Chunk* chunk;
+  while (ChunkHashMapIteratorNext(&it, NULL, &chunk))
+  {
+    if (chunk->needsMeshing) return false;
+  }
+  return true;
+}
+
+// Stands in for the GPU upload, finished meshes are thrown away and their
+// chunks can be scheduled again once they change
+static void DiscardReadyMeshes(void)
+{
+  ClearReadyChunkMeshes();
+
+  ChunkHashMapIterator it = ChunkHashMapIteratorCreate(loadedChunks);
+  Chunk* chunk;
+  while (ChunkHashMapIteratorNext(&it, NULL, &chunk)) chunk->meshTicket = 0;
+}
+
+// Streams in the world around center, generation and meshing included
+static void LoadWorld(const Vector3I center, const int distance)
+{
+  const int expectedChunks = CountChunksInSphere(distance);
+  do
+  {
+    LoadChunksAround(center, distance, 0.0f);
+    JobSystemWaitIdle();
+    JobSystemProcessCompleted(0);
+    DiscardReadyMeshes();
+  } while (!IsStreamingSettled(expectedChunks));
+}
+
+// Loaded chunks that have voxels, in map order
+static Chunk** CollectSolidChunks(int* count)
+{
+  Chunk** chunks = malloc(ChunkHashMapSize(loadedChunks) * sizeof(Chunk*));
+  *count = 0;
+  if (!chunks) return NULL;
+
+  ChunkHashMapIterator it = ChunkHashMapIteratorCreate(loadedChunks);
+  Chunk* chunk;
+  while (ChunkHashMapIteratorNext(&it, NULL, &chunk))
+  {
+    if (!ChunkVoxelsIsEmpty(&chunk->voxels)) chunks[(*count)++] = chunk;
+  }
+  return chunks;
+}
+
+// Without the column cache every chunk makes its own heightmap, with it the
+// chunks of a column share one like they do when streamed in
+static void BenchGenerateChunk(const char* name, const bool cached)
+{
+  if (!ShouldRun(name)) return;
+
+  long long ops = 0;
+  const uint64_t start = TimerNowNanoseconds();
+  uint64_t elapsed = 0;
+  while (elapsed < BENCH_MIN_NANOSECONDS)
+  {
+    // Columns crossing the surface plus the air and stone around it
+    for (int x = -4; x < 4; x++)
+    {
+      for (int y = -1; y < 3; y++)
+      {
+        for (int z = -4; z < 4; z++)
+        {
+          Chunk* chunk = ChunkPoolAcquire();
+          chunk->position = (Vector3I){x, y, z};
+          chunk->voxels = (ChunkVoxels){0};
+          chunk->column = cached ? HeightmapCacheAcquire(x, z) : NULL;
+          GenerateChunk(chunk);
+          benchSink += chunk->voxels.bitsPerIndex;
+          HeightmapCacheRelease(chunk->column);
+          ChunkPoolRelease(chunk);
+          ops++;
+        }
+      }
+    }
+    elapsed = TimerNowNanoseconds() - start;
+  }
+  Report(name, "chunk", ops, elapsed);
+  HeightmapCacheClear();
+}
+
+// Streaming churn without the generation, the oldest of a window of chunks is
+// released and a new one acquired per op. Its voxels are allocated the way
+// loading them from storage does, cycling through the index widths
+static void BenchChunkPool(void)
+{
+  if (!ShouldRun("chunk_pool_churn")) return;
+
+  Chunk** window = calloc(BENCH_POOL_CHUNKS, sizeof(Chunk*));
+  if (!window) return;
+
+  long long ops = 0;
+  const uint64_t start = TimerNowNanoseconds();
+  uint64_t elapsed = 0;
+  while (elapsed < BENCH_MIN_NANOSECONDS)
+  {
+    for (int i = 0; i < BENCH_POOL_CHUNKS; i++)
+    {
+      ChunkPoolRelease(window[i]);
+      Chunk* chunk = ChunkPoolAcquire();
+      chunk->voxels = (ChunkVoxels){0};
+      size_t size;
+      ChunkVoxelsRawAllocate(&chunk->voxels, 1 << (ops + i) % 4, 1, &size);
+      benchSink += chunk->voxels.bitsPerIndex;
+      window[i] = chunk;
+    }
+    ops += BENCH_POOL_CHUNKS;
+    elapsed = TimerNowNanoseconds() - start;
+  }
+  Report("chunk_pool_churn", "chunk", ops, elapsed);
+
+  for (int i = 0; i < BENCH_POOL_CHUNKS; i++) ChunkPoolRelease(window[i]);
+  free(window);
+}
+
+// One chunk wide row of terrain fBm per op, on every backend the CPU has
+static void BenchNoise(void)
+{
+  static const char* names[NOISE_BACKEND_COUNT] = {
+    "noise_fbm_row_scalar", "noise_fbm_row_sse2", "noise_fbm_row_avx2"};
+  const FbmNoise noise = {WORLD_SEED, 5, 1.0f / 128.0f, 2.0f, 0.5f};
+  const NoiseBackend previous = NoiseGetBackend();
+
+  for (int backend = 0; backend < NOISE_BACKEND_COUNT; backend++)
+  {
+    if (!ShouldRun(names[backend])) continue;
+    if (!NoiseSetBackend((NoiseBackend)backend))
+    {
+      fprintf(stderr, "bench: %s not supported\n", names[backend]);
+      continue;
+    }
+
+    long long ops = 0;
+    const uint64_t start = TimerNowNanoseconds();
+    uint64_t elapsed = 0;
+    while (elapsed < BENCH_MIN_NANOSECONDS)
+    {
+      float row[NOISE_ROW_WIDTH];
+      for (int z = 0; z < 1024; z++)
+      {
+        NoiseFbm2DRow(&noise, (int)ops, z, row);
+        benchSink += (uintptr_t)(row[0] > 0.0f);
+      }
+      ops += 1024;
+      elapsed = TimerNowNanoseconds() - start;
+    }
+    Report(names[backend], "row", ops, elapsed);
+  }
+  NoiseSetBackend(previous);
+}
+
+static void BenchMeshing(void)
+{
+  if (!ShouldRunAny(meshBenchmarks, 4)) return;
+
+  int chunkCount;
+  Chunk** chunks = CollectSolidChunks(&chunkCount);
+  ChunkMeshSnapshot* snapshot = malloc(sizeof(ChunkMeshSnapshot));
+  if (!chunks || !snapshot || chunkCount == 0)
+  {
+    fprintf(stderr, "bench: no chunks to mesh\n");
+    free(chunks);
+    free(snapshot);
+    return;
+  }
+
+  if (ShouldRun(meshBenchmarks[0]))
+  {
+    long long ops = 0;
+    const uint64_t start = TimerNowNanoseconds();
+    uint64_t elapsed = 0;
+    while (elapsed < BENCH_MIN_NANOSECONDS)
+    {
+      for (int i = 0; i < chunkCount; i++)
+        TakeChunkMeshSnapshot(chunks[i], snapshot);
+      ops += chunkCount;
+      elapsed = TimerNowNanoseconds() - start;
+    }
+    Report("mesh_snapshot", "chunk", ops, elapsed);
+  }
+
+  const MeshingMode modes[] = {MESHING_NAIVE, MESHING_GREEDY};
+  for (int mode = 0; mode < 2; mode++)
+  {
+    const char* name = meshBenchmarks[1 + mode];
+    if (!ShouldRun(name)) continue;
+
+    long long ops = 0;
+    long long quads = 0;
+    uint64_t elapsed = 0;
+    while (elapsed < BENCH_MIN_NANOSECONDS)
+    {
+      // Snapshots aren't part of the build, they're timed above
+      for (int i = 0; i < chunkCount; i++)
+      {
+        TakeChunkMeshSnapshot(chunks[i], snapshot);
+        ChunkMeshData data;
+        const uint64_t start = TimerNowNanoseconds();
+        BuildChunkMesh(snapshot, modes[mode], &data);
+        elapsed += TimerNowNanoseconds() - start;
+        quads += data.quadCount;
+        FreeChunkMeshData(&data);
+      }
+      ops += chunkCount;
+    }
+    Report(name, "chunk", ops, elapsed);
+    benchSink += quads;
+  }
+
+  // Remeshing after a voxel in the middle of the chunk changed, the layers
+  // on either side of it are meshed and the rest copied from the last mesh
+  if (ShouldRun(meshBenchmarks[3]))
+  {
+    long long ops = 0;
+    long long quads = 0;
+    uint64_t elapsed = 0;
+    while (elapsed < BENCH_MIN_NANOSECONDS)
+    {
+      for (int i = 0; i < chunkCount; i++)
+      {
+        TakeChunkMeshSnapshot(chunks[i], snapshot);
+        ChunkMeshData base;
+        BuildChunkMesh(snapshot, MESHING_GREEDY, &base);
+        if (!base.layered) continue;
+
+        snapshot->baseVertices = base.vertices;
+        snapshot->baseLayers = base.layers;
+        const int middle = CHUNK_SIZE / 2;
+        for (Face face = 0; face < 6; face++)
+          snapshot->dirtyLayers[face] = 3 << (middle - 1);
+
+        ChunkMeshData data;
+        const uint64_t start = TimerNowNanoseconds();
+        BuildChunkMesh(snapshot, MESHING_GREEDY, &data);
+        elapsed += TimerNowNanoseconds() - start;
+        quads += data.quadCount;
+        FreeChunkMeshData(&data);
+        FreeChunkMeshData(&base);
+        ops++;
+      }
+      if (ops == 0) break;
+    }
+    Report(meshBenchmarks[3], "chunk", ops, elapsed);
+    benchSink += quads;
+  }
+
+  free(snapshot);
+  free(chunks);
+}
+
+static void BenchChunkMap(void)
+{
+  if (!ShouldRunAny(chunkMapBenchmarks, 5)) return;
+
+  // Keys shaped like a loaded world, values are never dereferenced
+  const int radius = BENCH_MAP_KEY_RADIUS;
+  const int keyCount = CountChunksInSphere(radius);
+  ChunkKey* keys = malloc(keyCount * sizeof(ChunkKey));
+  ChunkKey* missingKeys = malloc(keyCount * sizeof(ChunkKey));
+  if (!keys || !missingKeys)
+  {
+    free(keys);
+    free(missingKeys);
+    return;
+  }
+  int count = 0;
+  for (int x = -radius; x <= radius; x++)
+  {
+    for (int y = -radius; y <= radius; y++)
+    {
+      for (int z = -radius; z <= radius; z++)
+      {
+        if (x * x + y * y + z * z > radius * radius) continue;
+        keys[count] = (ChunkKey){x, y, z};
+        missingKeys[count] = (ChunkKey){x + 4 * radius, y, z};
+        count++;
+      }
+    }
+  }
+  Chunk* value = (Chunk*)keys;
+
+  long long putOps = 0, getOps = 0, missOps = 0, removeOps = 0, iterOps = 0;
+  uint64_t putTime = 0, getTime = 0, missTime = 0, removeTime = 0;
+  uint64_t iterTime = 0;
+  while (putTime + getTime + missTime + removeTime + iterTime <
+         BENCH_MIN_NANOSECONDS)
+  {
+    ChunkHashMap* map = ChunkHashMapCreate(0);
+    if (!map) break;
+
+    uint64_t start = TimerNowNanoseconds();
+    for (int i = 0; i < keyCount; i++)
+      ChunkHashMapPut(map, keys[i], value);
+    putTime += TimerNowNanoseconds() - start;
+    putOps += keyCount;
+
+    start = TimerNowNanoseconds();
+    for (int i = 0; i < keyCount; i++)
+      benchSink += (uintptr_t)ChunkHashMapGet(map, keys[i]);
+    getTime += TimerNowNanoseconds() - start;
+    getOps += keyCount;
+
+    start = TimerNowNanoseconds();
+    for (int i = 0; i < keyCount; i++)
+      benchSink += (uintptr_t)ChunkHashMapGet(map, missingKeys[i]);
+    missTime += TimerNowNanoseconds() - start;
+    missOps += keyCount;
+
+    start = TimerNowNanoseconds();
+    ChunkHashMapIterator it = ChunkHashMapIteratorCreate(map);
+    Chunk* chunk;
+    while (ChunkHashMapIteratorNext(&it, NULL, &chunk))
+      benchSink += (uintptr_t)chunk;
+    iterTime += TimerNowNanoseconds() - start;
+    iterOps += keyCount;
+
+    start = TimerNowNanoseconds();
+    for (int i = 0; i < keyCount; i++)
+      ChunkHashMapRemove(map, keys[i]);
+    removeTime += TimerNowNanoseconds() - start;
+    removeOps += keyCount;
+
+    ChunkHashMapFree(map);
+  }
+
+  if (ShouldRun(chunkMapBenchmarks[0]))
+    Report(chunkMapBenchmarks[0], "key", putOps, putTime);
+  if (ShouldRun(chunkMapBenchmarks[1]))
+    Report(chunkMapBenchmarks[1], "key", getOps, getTime);
+  if (ShouldRun(chunkMapBenchmarks[2]))
+    Report(chunkMapBenchmarks[2], "key", missOps, missTime);
+  if (ShouldRun(chunkMapBenchmarks[3]))
+    Report(chunkMapBenchmarks[3], "key", removeOps, removeTime);
+  if (ShouldRun(chunkMapBenchmarks[4]))
+    Report(chunkMapBenchmarks[4], "entry", iterOps, iterTime);
+
+  free(keys);
+  free(missingKeys);
+}
+
+static void BenchRaycast(void)
+{
+  if (!ShouldRun("raycast")) return;
+
+  // Rays start above the terrain and head down at it at random angles
+  Vector3 starts[BENCH_RAY_COUNT];
+  Vector3 directions[BENCH_RAY_COUNT];
+  for (int i = 0; i < BENCH_RAY_COUNT; i++)
+  {
+    starts[i] = (Vector3){RandomFloat(-32.0f, 32.0f), RandomFloat(24.0f, 40.0f),
+                          RandomFloat(-32.0f, 32.0f)};
+    directions[i] =
+      (Vector3){RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, -0.2f),
+                RandomFloat(-1.0f, 1.0f)};
+  }
+
+  long long ops = 0;
+  int hits = 0;
+  const uint64_t start = TimerNowNanoseconds();
+  uint64_t elapsed = 0;
+  while (elapsed < BENCH_MIN_NANOSECONDS)
+  {
+    for (int i = 0; i < BENCH_RAY_COUNT; i++)
+      hits += Raycast(starts[i], directions[i], BENCH_RAY_LENGTH).hit;
+    ops += BENCH_RAY_COUNT;
+    elapsed = TimerNowNanoseconds() - start;
+  }
+  Report("raycast", "ray", ops, elapsed);
+  benchSink += hits;
+}
+
+// Reading a box of the world voxel by voxel through GetVoxel, then as a
+// single GetVoxelRegion
+static void BenchVoxelReads(void)
+{
+  if (!ShouldRunAny(readBenchmarks, 2)) return;
+
+  const Vector3I min = {-BENCH_READ_BOX_SIZE / 2, -BENCH_READ_BOX_SIZE / 2,
+                        -BENCH_READ_BOX_SIZE / 2};
+  const Vector3I max = {min.x + BENCH_READ_BOX_SIZE - 1,
+                        min.y + BENCH_READ_BOX_SIZE - 1,
+                        min.z + BENCH_READ_BOX_SIZE - 1};
+  const long long boxVoxels =
+    BENCH_READ_BOX_SIZE * BENCH_READ_BOX_SIZE * BENCH_READ_BOX_SIZE;
+  unsigned char* types = malloc((size_t)boxVoxels);
+  if (!types) return;
+
+  for (int region = 0; region < 2; region++)
+  {
+    if (!ShouldRun(readBenchmarks[region])) continue;
+
+    long long ops = 0;
+    const uint64_t start = TimerNowNanoseconds();
+    uint64_t elapsed = 0;
+    while (elapsed < BENCH_MIN_NANOSECONDS)
+    {
+      if (region)
+        GetVoxelRegion(min, max, types);
+      else
+      {
+        unsigned char* out = types;
+        for (int z = min.z; z <= max.z; z++)
+          for (int y = min.y; y <= max.y; y++)
+            for (int x = min.x; x <= max.x; x++)
+              *out++ = GetVoxel((Vector3){x + 0.5f, y + 0.5f, z + 0.5f}).type;
+      }
+      benchSink += types[ops % boxVoxels];
+      ops += boxVoxels;
+      elapsed = TimerNowNanoseconds() - start;
+    }
+    Report(readBenchmarks[region], "voxel", ops, elapsed);
+  }
+  free(types);
+}
+
+// Filling a box across chunk borders with stone and clearing it again, voxel
+// by voxel through PlaceVoxel, then as one bulk edit. Remeshing is left out,
+// both only flag each chunk once
+static void BenchVoxelEdits(void)
+{
+  if (!ShouldRunAny(editBenchmarks, 2)) return;
+
+  const Vector3I min = {-BENCH_EDIT_BOX_SIZE / 2, -BENCH_EDIT_BOX_SIZE / 2,
+                        -BENCH_EDIT_BOX_SIZE / 2};
+  const Vector3I max = {min.x + BENCH_EDIT_BOX_SIZE - 1,
+                        min.y + BENCH_EDIT_BOX_SIZE - 1,
+                        min.z + BENCH_EDIT_BOX_SIZE - 1};
+  const long long boxVoxels =
+    BENCH_EDIT_BOX_SIZE * BENCH_EDIT_BOX_SIZE * BENCH_EDIT_BOX_SIZE;
+
+  for (int bulk = 0; bulk < 2; bulk++)
+  {
+    if (!ShouldRun(editBenchmarks[bulk])) continue;
+
+    long long ops = 0;
+    int pass = 0;
+    const uint64_t start = TimerNowNanoseconds();
+    uint64_t elapsed = 0;
+    while (elapsed < BENCH_MIN_NANOSECONDS)
+    {
+      const VoxelType type = pass++ % 2 ? AIR : STONE;
+      if (bulk)
+        benchSink += FillVoxelBox(min, max, type);
+      else
+      {
+        for (int z = min.z; z <= max.z; z++)
+          for (int y = min.y; y <= max.y; y++)
+            for (int x = min.x; x <= max.x; x++)
+              PlaceVoxel((Vector3){x + 0.5f, y + 0.5f, z + 0.5f}, type);
+      }
+      ops += boxVoxels;
+      elapsed = TimerNowNanoseconds() - start;
+    }
+    Report(editBenchmarks[bulk], "voxel", ops, elapsed);
+  }
+}
+
+// Region file round trips, then streaming a world that was saved before
+static void BenchStorage(void)
+{
+  if (!ShouldRunAny(storageBenchmarks, 3)) return;
+  if (!RegionStoreOpen(BENCH_SAVE_DIRECTORY))
+  {
+    fprintf(stderr, "bench: failed to open %s\n", BENCH_SAVE_DIRECTORY);
+    return;
+  }
+
+  const Vector3I center = {0, 0, 0};
+  LoadWorld(center, BENCH_WORLD_DISTANCE);
+  int chunkCount;
+  Chunk** chunks = CollectSolidChunks(&chunkCount);
+  if (chunks && chunkCount > 0)
+  {
+    for (int i = 0; i < chunkCount; i++)
+      ChunkStorageSave(chunks[i]);
+
+    if (ShouldRun(storageBenchmarks[0]))
+    {
+      long long ops = 0;
+      const uint64_t start = TimerNowNanoseconds();
+      uint64_t elapsed = 0;
+      while (elapsed < BENCH_MIN_NANOSECONDS)
+      {
+        for (int i = 0; i < chunkCount; i++)
+          benchSink += ChunkStorageSave(chunks[i]);
+        ops += chunkCount;
+        elapsed = TimerNowNanoseconds() - start;
+      }
+      Report(storageBenchmarks[0], "chunk", ops, elapsed);
+    }
+
+    if (ShouldRun(storageBenchmarks[1]))
+    {
+      Chunk scratch = {0};
+      long long ops = 0;
+      const uint64_t start = TimerNowNanoseconds();
+      uint64_t elapsed = 0;
+      while (elapsed < BENCH_MIN_NANOSECONDS)
+      {
+        for (int i = 0; i < chunkCount; i++)
+        {
+          scratch.position = chunks[i]->position;
+          benchSink += ChunkStorageLoad(&scratch);
+          ChunkVoxelsFree(&scratch.voxels);
+        }
+        ops += chunkCount;
+        elapsed = TimerNowNanoseconds() - start;
+      }
+      Report(storageBenchmarks[1], "chunk", ops, elapsed);
+    }
+  }
+  free(chunks);
+  // Saves whatever chunks are left, so the whole world is on disk
+  DestroyWorld();
+
+  // Same as stream_cold_load, but every chunk comes out of the region files
+  char name[64];
+  snprintf(name, sizeof(name), "%s_d%d", storageBenchmarks[2],
+           BENCH_WORLD_DISTANCE);
+  if (ShouldRun(name))
+  {
+    long long ops = 0;
+    uint64_t elapsed = 0;
+    for (int run = 0; run < 3 || elapsed < BENCH_MIN_NANOSECONDS; run++)
+    {
+      const uint64_t start = TimerNowNanoseconds();
+      LoadWorld(center, BENCH_WORLD_DISTANCE);
+      elapsed += TimerNowNanoseconds() - start;
+      ops += CountChunksInSphere(BENCH_WORLD_DISTANCE);
+      DestroyWorld();
+    }
+    Report(name, "chunk", ops, elapsed);
+  }
+
+  RegionStoreDelete();
+}
+
+static void BenchStreaming(void)
+{
+  const Vector3I center = {0, 0, 0};
+  const int distanceCount =
+    sizeof(streamingDistances) / sizeof(streamingDistances[0]);
+  for (int i = 0; i < distanceCount; i++)
+  {
+    const int distance = streamingDistances[i];
+    const int chunkCount = CountChunksInSphere(distance);
+    char name[64];
+
+    // Everything from an empty world to generated and meshed chunks
+    snprintf(name, sizeof(name), "stream_cold_load_d%d", distance);
+    if (ShouldRun(name))
+    {
+      long long ops = 0;
+      uint64_t elapsed = 0;
+      for (int run = 0; run < 3 || elapsed < BENCH_MIN_NANOSECONDS; run++)
+      {
+        const uint64_t start = TimerNowNanoseconds();
+        LoadWorld(center, distance);
+        elapsed += TimerNowNanoseconds() - start;
+        ops += chunkCount;
+        DestroyWorld();
+      }
+      Report(name, "chunk", ops, elapsed);
+    }
+
+    // The frame that finds an empty world, held to the streaming budget
+    snprintf(name, sizeof(name), "stream_first_frame_d%d", distance);
+    if (ShouldRun(name))
+    {
+      long long ops = 0;
+      uint64_t elapsed = 0;
+      while (ops < 3 || elapsed < BENCH_MIN_NANOSECONDS)
+      {
+        const uint64_t start = TimerNowNanoseconds();
+        LoadChunksAround(center, distance, STREAMING_BUDGET_MS);
+        elapsed += TimerNowNanoseconds() - start;
+        ops++;
+        DestroyWorld();
+      }
+      Report(name, "call", ops, elapsed);
+    }
+
+    // The per frame cost once nothing is left to load
+    snprintf(name, sizeof(name), "stream_steady_d%d", distance);
+    if (ShouldRun(name))
+    {
+      LoadWorld(center, distance);
+      long long ops = 0;
+      const uint64_t start = TimerNowNanoseconds();
+      uint64_t elapsed = 0;
+      while (elapsed < BENCH_MIN_NANOSECONDS)
+      {
+        LoadChunksAround(center, distance, 0.0f);
+        ops++;
+        elapsed = TimerNowNanoseconds() - start;
+      }
+      Report(name, "call", ops, elapsed);
+      DestroyWorld();
+    }
+
+    // Stepping back and forth over a chunk border, a shell of chunks is
+    // unloaded and loaded again every step
+    snprintf(name, sizeof(name), "stream_border_step_d%d", distance);
+    if (ShouldRun(name))
+    {
+      const Vector3I neighbor = {1, 0, 0};
+      LoadWorld(center, distance);
+      long long ops = 0;
+      const uint64_t start = TimerNowNanoseconds();
+      uint64_t elapsed = 0;
+      while (elapsed < BENCH_MIN_NANOSECONDS)
+      {
+        LoadWorld(ops % 2 ? center : neighbor, distance);
+        ops++;
+        elapsed = TimerNowNanoseconds() - start;
+      }
+      Report(name, "step", ops, elapsed);
+      DestroyWorld();
+    }
+  }
+}
+
+int main(const int argc, char** argv)
+{
+  if (argc > 1) benchFilter = argv[1];
+
+  // TraceLog writes to stdout, keep it for real problems
+  SetTraceLogLevel(LOG_ERROR);
+  NoiseInit();
+  ChunkPoolInit();
+  JobSystemInit(WORKER_THREAD_COUNT);
+
+  fprintf(stderr, "bench: %d worker threads, %s noise\n",
+          JobSystemWorkerCount(), NoiseBackendName(NoiseGetBackend()));
+  printf("benchmark,unit,ops,total_ms,ns_per_op,ops_per_sec\n");
+
+  BenchGenerateChunk("generate_chunk", false);
+  BenchGenerateChunk("generate_chunk_cached_column", true);
+  BenchNoise();
+  BenchChunkMap();
+  BenchChunkPool();
+
+  // Meshing, raycasts, reads and edits run against a streamed in world, edits
+  // last as they change it
+  if (ShouldRunAny(meshBenchmarks, 4) || ShouldRun("raycast") ||
+      ShouldRunAny(readBenchmarks, 2) || ShouldRunAny(editBenchmarks, 2))
+  {
+    LoadWorld((Vector3I){0, 0, 0}, BENCH_WORLD_DISTANCE);
+    BenchMeshing();
+    BenchRaycast();
+    BenchVoxelReads();
+    BenchVoxelEdits();
+    DestroyWorld();
+  }
+
+  BenchStreaming();
+  BenchStorage();
+
+  JobSystemShutdown();
+  ChunkPoolShutdown();
+  MeshArenaShutdown();
+  return 0;
+}
@@ -48,6 +48,7 @@ typedef enum VoxelType
   DIRT = 1,
   GRASS = 2,
   STONE = 3,
+  VOXEL_TYPE_COUNT // Not a type, every valid one is below it
 } VoxelType;
 
 typedef enum Face
@@ -60,13 +61,42 @@ typedef enum Face
   BACK = 5,
 } Face;
 
+typedef enum MeshingMode
+{
+  MESHING_NAIVE = 0,
+  MESHING_GREEDY = 1,
+} MeshingMode;
+
 typedef struct Voxel
 {
   VoxelType type;
 } Voxel;
 
+// Palette compressed voxels of a chunk, see chunkVoxels
+typedef struct ChunkVoxels
+{
+  unsigned char* indices;  // Bit packed palette entry of every voxel
+  unsigned char* palette;  // Voxel type of each palette entry
+  unsigned short* counts;  // Voxels using each palette entry, owns the memory
+  unsigned short paletteSize;
+  unsigned char bitsPerIndex; // 1, 2, 4 or 8, 0 while the chunk is uniform
+  unsigned char uniformType;  // Type of every voxel while the chunk is uniform
+} ChunkVoxels;
+
 // Forward declaration of Chunk
 struct ChunkPoolBlock;
+struct DrawRegionPage;
+struct HeightmapColumn;
+
+// GPU side of a chunk mesh, a range of quads in the vertex buffer of its draw
+// region (see drawRegions)
+typedef struct ChunkGpuMesh
+{
+  struct DrawRegionPage* page; // NULL while the chunk has no mesh uploaded
+  int firstQuad;
+  int quadCount;
+  int quadCapacity; // Quads reserved for the chunk in the page
+} ChunkGpuMesh;
 
 typedef struct Chunk
 {
@@ -76,9 +106,17 @@ typedef struct Chunk
     Vector3I position;
     struct Chunk* nextFree; // for pool management
   };
-  Voxel* voxels;
+  ChunkVoxels voxels;
   bool needsMeshing;
-  Model model;
+  unsigned int dirtyLayers[3]; // Edited layers along x, y and z, bit masks
+  bool unsaved; // Voxels differ from what the region files hold
+  unsigned int meshTicket; // Latest queued mesh job, 0 if none is in flight
+  unsigned char lodLevel;  // Level of detail of the latest mesh scheduled
+  unsigned short faceConnections; // Face pairs joined by air, see caveCulling
+  unsigned int cullStamp;         // Last cave culling walk that reached it
+  ChunkGpuMesh mesh;
+  int naiveQuadCount;
+  struct HeightmapColumn* column; // Held while generating, see heightmapCache
 } Chunk;
 
 #define VOXEL_INDEX(x, y, z) ((x) + CHUNK_SIZE * ((y) + CHUNK_SIZE * (z)))
@@ -106,10 +144,4 @@ static bool MapCompareVector3I(const void* key1, const void* key2)
   return vec1->x == vec2->x && vec1->y == vec2->y && vec1->z == vec2->z;
 }
 
-#define REMOVE_CHUNK_MODEL(chunk)                                              \
-  {                                                                            \
-    UnloadModel((chunk)->model);                                               \
-    (chunk)->model.meshCount = 0;                                              \
-  }
-
 #endif // DATA_TYPES_H
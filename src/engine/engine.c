@@ -24,9 +24,16 @@
 *******************************************************************************/
 
 #include "engine.h"
+#include "chunkPool.h"
+#include "chunkRenderer.h"
+#include "drawRegions.h"
 #include "gui.h"
+#include "jobSystem.h"
+#include "meshArena.h"
+#include "noise.h"
 #include "player.h"
 #include "raylib.h"
+#include "regionFile.h"
 #include "settings.h"
 #include "world.h"
 
@@ -47,12 +54,24 @@ void Initialize()
 
   InitGui();
   InitPlayer();
+  InitChunkRenderer();
+  NoiseInit();
+  ChunkPoolInit();
+  JobSystemInit(WORKER_THREAD_COUNT);
+
+  if (!RegionStoreOpen(WORLD_SAVE_DIRECTORY))
+    TraceLog(LOG_WARNING, "World won't be saved, failed to open %s",
+             WORLD_SAVE_DIRECTORY);
 }
 
 void Update()
 {
+  // Hand finished background work back to the world
+  JobSystemProcessCompleted(0);
+
   // Update world
   LoadChunksInRenderDistance();
+  UploadChunkMeshes();
   UpdatePlayer(GetFrameTime());
 
   // Todo - Move this to an actual input handler file
@@ -64,7 +83,16 @@ void Update()
 // Deconstruct the engine
 void Deconstruct()
 {
-  // Cleaning up GUI
+  // Saving the world, then stopping background workers
+  DestroyWorld();
+  JobSystemShutdown();
+  RegionStoreClose();
+  ChunkPoolShutdown();
+  MeshArenaShutdown();
+
+  // Cleaning up rendering
+  FreeDrawRegions();
+  EndChunkRenderer();
   EndGui();
 
   // Cleaning up window
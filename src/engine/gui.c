@@ -26,21 +26,41 @@
 #define CIMGUI_DEFINE_ENUMS_AND_STRUCTS
 
 #include "gui.h"
+#include "caveCulling.h"
+#include "chunkColdTier.h"
+#include "chunkMeshGeneration.h"
+#include "chunkPool.h"
 #include "cimgui.h"
+#include "drawRegions.h"
+#include "heightmapCache.h"
+#include "meshArena.h"
 #include "player.h"
 #include "raylib.h"
+#include "regionFile.h"
 #include "rlImGui.h"
 #include "settings.h"
 #include "world.h"
 
 bool drawWireFrame = false;
 bool drawChunkBorders = false;
+bool frustumCulling = true;
+bool caveCulling = true;
 int drawDistance = DEFAULT_DRAW_DISTANCE;
+float streamingBudget = STREAMING_BUDGET_MS;
+int lodDistance = LOD_DISTANCE;
+int meshingMode = MESHING_GREEDY;
+
+static const char* meshingModeNames[] = {"Naive", "Greedy"};
 
 // Variable Fetching
 bool GetDrawWireFrame() { return drawWireFrame; }
 bool GetDrawChunkBorders() { return drawChunkBorders; }
 int GetDrawDistance() { return drawDistance; }
+float GetStreamingBudget() { return streamingBudget; }
+int GetLodDistance() { return lodDistance; }
+MeshingMode GetMeshingMode() { return meshingMode; }
+bool GetFrustumCulling() { return frustumCulling; }
+bool GetCaveCulling() { return caveCulling; }
 
 void InitGui()
 {
@@ -73,14 +93,136 @@ void DrawDebugGui()
   igText("Player Chunk Position %d, %d, %d", playerChunk.x, playerChunk.y,
          playerChunk.z);
 
+  igSeparatorText("Mesh Stats");
+
+  // Quads are 4 packed 32 bit vertices, indices are shared by every chunk.
+  // The old format was 6 vertices of 3 floats and 4 bytes of color per quad
+  const ChunkMeshStats meshStats = GetChunkMeshStats();
+  const float mebibyte = 1024.0f * 1024.0f;
+  igText("Chunk Meshes %d", meshStats.meshCount);
+  igText("Quads %lld (%.1f MiB)", meshStats.quadCount,
+         (float)meshStats.quadCount * 16.0f / mebibyte);
+  igText("Unpacked Equivalent %.1f MiB",
+         (float)meshStats.quadCount * 96.0f / mebibyte);
+  igText("Naive Mesher Quads %lld (%.1f MiB)", meshStats.naiveQuadCount,
+         (float)meshStats.naiveQuadCount * 16.0f / mebibyte);
+  if (meshStats.naiveQuadCount > 0)
+  {
+    igText("Quad Reduction %.1f%%",
+           100.0f * (1.0f - (float)meshStats.quadCount /
+                              (float)meshStats.naiveQuadCount));
+  }
+  igText("Reserved Quads %.1f MiB",
+         (float)meshStats.bufferQuadCount * 16.0f / mebibyte);
+  if (meshStats.uploads > 0)
+  {
+    igText("Uploads In Place %.1f%%",
+           100.0 * (double)meshStats.inPlaceUploads /
+             (double)meshStats.uploads);
+  }
+  // Edits only remesh the layers they touched, see MarkChunkVoxelDirty
+  igText("Partial Remeshes %lld", meshStats.partialUploads);
+
+  // Vertices built on the CPU, mostly waiting to be uploaded
+  const MeshArenaStats arenaStats = MeshArenaGetStats();
+  igText("Mesh Arena %.1f MiB (%d blocks, %d free)",
+         (float)arenaStats.bytes / mebibyte, arenaStats.blockCount,
+         arenaStats.freeBlockCount);
+  igText("Pending Mesh Allocations %d", arenaStats.allocationCount);
+
+  igSeparatorText("Render Stats");
+
+  // Counted while drawing the previous frame
+  const DrawRegionStats regionStats = GetDrawRegionStats();
+  igText("Region Pages %d (%d spare)", regionStats.pageCount,
+         regionStats.spareCount);
+  igText("Region Buffers %.1f MiB",
+         (float)regionStats.quadCapacity * 16.0f / mebibyte);
+  if (caveCulling)
+  {
+    // Only the visible chunks' ranges are drawn, pages aren't tested
+    const CaveCullStats caveStats = GetCaveCullStats();
+    igText("Chunks Reached %d (%d meshed)", caveStats.visited,
+           caveStats.drawn);
+  }
+  else
+  {
+    igText("Pages Culled %d / %d", regionStats.culled, regionStats.tested);
+  }
+  igText("Draw Calls %d", regionStats.drawn);
+
+  igSeparatorText("Voxel Stats");
+
+  // Chunks used to be a 4 byte Voxel per voxel, palettes pack them to 1-8 bits
+  const VoxelMemoryStats voxelStats = GetVoxelMemoryStats();
+  igText("Loaded Chunks %d", voxelStats.chunkCount);
+  igText("Chunks With Palettes %d", voxelStats.storedChunkCount);
+  igText("Solid Chunks %d", voxelStats.solidChunkCount);
+  igText("Voxel Memory %.1f MiB", (float)voxelStats.bytes / mebibyte);
+  igText("Unpacked Equivalent %.1f MiB",
+         (float)(voxelStats.storedChunkCount + voxelStats.solidChunkCount) *
+           CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE * sizeof(Voxel) / mebibyte);
+
+  // Chunk headers and voxel memory come out of the chunk pool, empty blocks
+  // and slabs are kept for a while instead of being freed straight away
+  const ChunkPoolStats poolStats = ChunkPoolGetStats();
+  size_t slabUsed = 0;
+  size_t slabReserved = 0;
+  int emptySlabs = 0;
+  for (int i = 0; i < CHUNK_POOL_VOXEL_CLASSES; i++)
+  {
+    const SlabAllocatorStats* slab = &poolStats.voxelClasses[i];
+    slabUsed += (size_t)slab->usedSlots * slab->slotSize;
+    slabReserved += (size_t)slab->slotCapacity * slab->slotSize;
+    emptySlabs += slab->emptySlabCount;
+  }
+  igText("Pooled Chunks %d / %d (%d empty blocks)", poolStats.chunksInUse,
+         poolStats.chunkCapacity, poolStats.emptyBlockCount);
+  igText("Voxel Slabs %.1f / %.1f MiB (%d empty)",
+         (float)slabUsed / mebibyte, (float)slabReserved / mebibyte,
+         emptySlabs);
+
+  const HeightmapCacheStats heightStats = HeightmapCacheGetStats();
+  const long long columnRequests = heightStats.hits + heightStats.misses;
+  igText("Heightmap Columns %d", heightStats.columnCount);
+  if (columnRequests > 0)
+  {
+    igText("Heightmap Reuse %.1f%%",
+           100.0 * (double)heightStats.hits / (double)columnRequests);
+  }
+
+  // Unloaded chunks kept compressed, re-entering them skips generation
+  const ChunkColdTierStats coldStats = ChunkColdTierGetStats();
+  const long long coldRequests = coldStats.hits + coldStats.misses;
+  igText("Cold Chunks %d", coldStats.chunkCount);
+  igText("Cold Memory %.1f / %.0f MiB", (float)coldStats.bytes / mebibyte,
+         (float)coldStats.budget / mebibyte);
+  if (coldRequests > 0)
+  {
+    igText("Cold Hit Rate %.1f%%",
+           100.0 * (double)coldStats.hits / (double)coldRequests);
+  }
+  igText("Open Regions %d", RegionStoreOpenRegionCount());
+
   igSeparatorText("Game Options");
   igTextWrapped(
     "WARNING: The memory requirements for anything over 20 is ridiculous");
   igInputInt("Draw Distance", &drawDistance, 1, 100, ImGuiInputTextFlags_None);
+  igInputInt("LOD Distance", &lodDistance, 1, 8, ImGuiInputTextFlags_None);
+  if (lodDistance < 0) lodDistance = 0;
+  igTextWrapped("Chunks past the LOD distance are meshed at half resolution, "
+                "halving again every time the distance doubles. 0 turns it "
+                "off");
+  igSliderFloat("Streaming Budget (ms)", &streamingBudget, 0.25f, 16.0f,
+                "%.2f", ImGuiSliderFlags_None);
 
   igSeparatorText("Debug Options");
   igCheckbox("Wireframe", &drawWireFrame);
   igCheckbox("Chunk Borders", &drawChunkBorders);
+  igCheckbox("Frustum Culling", &frustumCulling);
+  igCheckbox("Cave Culling", &caveCulling);
+  if (igCombo_Str_arr("Mesher", &meshingMode, meshingModeNames, 2, -1))
+    RemeshWorld();
 
   if (igButton("Regenerate Chunks", (ImVec2){150, 20})) { DestroyWorld(); }
 
@@ -27,6 +27,7 @@
 #define GUI_H
 
 #include <stdbool.h>
+#include "dataTypes.h"
 
 void InitGui();
 void DrawDebugGui();
@@ -37,5 +38,10 @@ void ToggleCursor();
 bool GetDrawWireFrame();
 bool GetDrawChunkBorders();
 int GetDrawDistance();
+float GetStreamingBudget();
+int GetLodDistance();
+MeshingMode GetMeshingMode();
+bool GetFrustumCulling();
+bool GetCaveCulling();
 
 #endif // GUI_H
@@ -0,0 +1,269 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Note: tinycthread pulls in windows.h on Windows, which clashes with raylib,
+// so this file must not include raylib.h (or anything that includes it).
+
+#include "jobSystem.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "tinycthread.h"
+
+#if defined(_WIN32)
+// windows.h is already included by tinycthread
+#else
+  #include <unistd.h>
+#endif
+
+#define MAX_WORKER_THREADS 64
+
+typedef struct Job
+{
+  JobExecuteFunction execute;
+  JobCompleteFunction complete;
+  void* data;
+  struct Job* next;
+} Job;
+
+typedef struct JobQueue
+{
+  Job* head;
+  Job* tail;
+  int size;
+} JobQueue;
+
+static thrd_t workers[MAX_WORKER_THREADS];
+static int workerCount = 0;
+static bool running = false;
+
+// Jobs waiting for a worker, guarded by queueMutex
+static JobQueue queuedJobs = {0};
+static int executingJobs = 0;
+static mtx_t queueMutex;
+static cnd_t jobAvailable;
+static cnd_t jobsIdle;
+
+// Jobs waiting for their completion callback, guarded by completedMutex
+static JobQueue completedJobs = {0};
+static mtx_t completedMutex;
+
+// Helpers
+
+static void JobQueuePush(JobQueue* queue, Job* job)
+{
+  job->next = NULL;
+  if (queue->tail)
+    queue->tail->next = job;
+  else
+    queue->head = job;
+  queue->tail = job;
+  queue->size++;
+}
+
+static Job* JobQueuePop(JobQueue* queue)
+{
+  Job* job = queue->head;
+  if (!job) return NULL;
+  queue->head = job->next;
+  if (!queue->head) queue->tail = NULL;
+  queue->size--;
+  return job;
+}
+
+static int DetectCoreCount(void)
+{
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return (int)info.dwNumberOfProcessors;
+#else
+  const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  return cores > 0 ? (int)cores : 1;
+#endif
+}
+
+// Executes a job and hands it over to the completed queue
+static void RunJob(Job* job)
+{
+  job->execute(job->data);
+
+  mtx_lock(&completedMutex);
+  JobQueuePush(&completedJobs, job);
+  mtx_unlock(&completedMutex);
+}
+
+static int WorkerMain(void* arg)
+{
+  (void)arg;
+
+  mtx_lock(&queueMutex);
+  while (true)
+  {
+    while (running && !queuedJobs.head)
+      cnd_wait(&jobAvailable, &queueMutex);
+
+    // Only exit once the queue has been drained
+    if (!queuedJobs.head) break;
+
+    Job* job = JobQueuePop(&queuedJobs);
+    executingJobs++;
+    mtx_unlock(&queueMutex);
+
+    RunJob(job);
+
+    mtx_lock(&queueMutex);
+    executingJobs--;
+    if (!queuedJobs.head && executingJobs == 0) cnd_broadcast(&jobsIdle);
+  }
+  mtx_unlock(&queueMutex);
+
+  return 0;
+}
+
+void JobSystemInit(int requestedWorkers)
+{
+  if (running) return;
+
+  if (requestedWorkers <= 0) requestedWorkers = DetectCoreCount() - 1;
+  if (requestedWorkers < 1) requestedWorkers = 1;
+  if (requestedWorkers > MAX_WORKER_THREADS)
+    requestedWorkers = MAX_WORKER_THREADS;
+
+  mtx_init(&queueMutex, mtx_plain);
+  mtx_init(&completedMutex, mtx_plain);
+  cnd_init(&jobAvailable);
+  cnd_init(&jobsIdle);
+
+  running = true;
+  workerCount = 0;
+  for (int i = 0; i < requestedWorkers; i++)
+  {
+    if (thrd_create(&workers[workerCount], WorkerMain, NULL) != thrd_success)
+    {
+      fprintf(stderr, "JobSystem: Failed to create worker thread %d\n", i);
+      break;
+    }
+    workerCount++;
+  }
+}
+
+void JobSystemShutdown(void)
+{
+  if (!running) return;
+
+  mtx_lock(&queueMutex);
+  running = false;
+  cnd_broadcast(&jobAvailable);
+  mtx_unlock(&queueMutex);
+
+  for (int i = 0; i < workerCount; i++)
+    thrd_join(workers[i], NULL);
+  workerCount = 0;
+
+  // Nobody is left to complete these, so just drop them
+  Job* job;
+  while ((job = JobQueuePop(&completedJobs)))
+    free(job);
+
+  cnd_destroy(&jobsIdle);
+  cnd_destroy(&jobAvailable);
+  mtx_destroy(&completedMutex);
+  mtx_destroy(&queueMutex);
+}
+
+bool JobSystemSubmit(const JobExecuteFunction execute,
+                     const JobCompleteFunction complete, void* data)
+{
+  if (!running || !execute) return false;
+
+  Job* job = malloc(sizeof(Job));
+  if (!job) return false;
+  job->execute = execute;
+  job->complete = complete;
+  job->data = data;
+
+  // Without any workers the job runs right away on the calling thread
+  if (workerCount == 0)
+  {
+    RunJob(job);
+    return true;
+  }
+
+  mtx_lock(&queueMutex);
+  JobQueuePush(&queuedJobs, job);
+  cnd_signal(&jobAvailable);
+  mtx_unlock(&queueMutex);
+  return true;
+}
+
+int JobSystemProcessCompleted(const int maxJobs)
+{
+  // Detach the finished jobs first so workers aren't blocked by callbacks
+  JobQueue finished = {0};
+  mtx_lock(&completedMutex);
+  if (maxJobs <= 0 || completedJobs.size <= maxJobs)
+  {
+    finished = completedJobs;
+    completedJobs = (JobQueue){0};
+  }
+  else
+  {
+    for (int i = 0; i < maxJobs; i++)
+      JobQueuePush(&finished, JobQueuePop(&completedJobs));
+  }
+  mtx_unlock(&completedMutex);
+
+  int processed = 0;
+  Job* job;
+  while ((job = JobQueuePop(&finished)))
+  {
+    if (job->complete) job->complete(job->data);
+    free(job);
+    processed++;
+  }
+  return processed;
+}
+
+void JobSystemWaitIdle(void)
+{
+  if (workerCount == 0) return;
+
+  mtx_lock(&queueMutex);
+  while (queuedJobs.head || executingJobs > 0)
+    cnd_wait(&jobsIdle, &queueMutex);
+  mtx_unlock(&queueMutex);
+}
+
+int JobSystemWorkerCount(void) { return workerCount; }
+
+int JobSystemPendingCount(void)
+{
+  if (workerCount == 0) return 0;
+
+  mtx_lock(&queueMutex);
+  const int pending = queuedJobs.size + executingJobs;
+  mtx_unlock(&queueMutex);
+  return pending;
+}
@@ -0,0 +1,56 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <stdbool.h>
+
+// Runs on a worker thread, must not touch anything owned by the main thread
+typedef void (*JobExecuteFunction)(void* data);
+// Runs on the main thread once the job has been executed
+typedef void (*JobCompleteFunction)(void* data);
+
+/* Start the worker threads, a count of 0 or less picks one per spare core */
+void JobSystemInit(int workerCount);
+
+/* Wait for all queued jobs to finish and stop the worker threads */
+void JobSystemShutdown(void);
+
+/* Queue a job, complete may be NULL if the main thread doesn't need to know */
+bool JobSystemSubmit(JobExecuteFunction execute, JobCompleteFunction complete,
+                     void* data);
+
+/* Run the completion callbacks of finished jobs, a max of 0 runs all of them.
+ * Returns the number of completions processed */
+int JobSystemProcessCompleted(int maxJobs);
+
+/* Block until every submitted job has been executed */
+void JobSystemWaitIdle(void);
+
+int JobSystemWorkerCount(void);
+int JobSystemPendingCount(void);
+
+#endif // JOB_SYSTEM_H
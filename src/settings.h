@@ -50,6 +50,16 @@
 
 // World settings
 #define CHUNK_SIZE (16)
+#define WORLD_SEED (1337)
+#define WORLD_SAVE_DIRECTORY "world"        // Region files, relative to the cwd
+#define COLD_TIER_BUDGET (32 * 1024 * 1024) // Bytes of unloaded chunks kept
 #define DEFAULT_DRAW_DISTANCE (10)
+#define LOD_DISTANCE (8) // Chunks out before meshes drop resolution, 0 for off
+#define MESH_UPLOADS_PER_FRAME (16) // Max chunk meshes sent to the GPU a frame
+#define STREAMING_BUDGET_MS (2.0f)  // Frame time spent requesting chunks
+#define POOL_RETAINED_BLOCKS (8)    // Empty chunk pool blocks kept per size
+
+// Engine settings
+#define WORKER_THREAD_COUNT (0) // 0 uses one worker per core, minus the main one
 
 #endif // SETTINGS_H
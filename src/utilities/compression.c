@@ -0,0 +1,203 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "compression.h"
+#include <stdint.h>
+#include <string.h>
+
+#define LZ_MIN_MATCH 4
+#define LZ_MAX_OFFSET 65535
+#define LZ_HASH_BITS 12
+#define LZ_LENGTH_MASK 15 // A 4 bit length of 15 continues in extra bytes
+
+static uint32_t Read32(const unsigned char* bytes)
+{
+  uint32_t value;
+  memcpy(&value, bytes, sizeof(value));
+  return value;
+}
+
+static uint32_t HashSequence(const uint32_t sequence)
+{
+  return sequence * 2654435761u >> (32 - LZ_HASH_BITS);
+}
+
+static unsigned char* WriteLength(unsigned char* out, const unsigned char* end,
+                                  size_t length)
+{
+  while (length >= 255)
+  {
+    if (out >= end) return NULL;
+    *out++ = 255;
+    length -= 255;
+  }
+  if (out >= end) return NULL;
+  *out++ = (unsigned char)length;
+  return out;
+}
+
+// Emits literals followed by a match, or just the literals if matchLength is 0
+static unsigned char* WriteSequence(unsigned char* out,
+                                    const unsigned char* end,
+                                    const unsigned char* literals,
+                                    const size_t literalLength,
+                                    const size_t offset,
+                                    const size_t matchLength)
+{
+  const size_t literalCode =
+    literalLength < LZ_LENGTH_MASK ? literalLength : LZ_LENGTH_MASK;
+  const size_t matchExtra = matchLength ? matchLength - LZ_MIN_MATCH : 0;
+  const size_t matchCode =
+    matchExtra < LZ_LENGTH_MASK ? matchExtra : LZ_LENGTH_MASK;
+
+  if (out >= end) return NULL;
+  *out++ = (unsigned char)(literalCode << 4 | matchCode);
+  if (literalCode == LZ_LENGTH_MASK)
+  {
+    out = WriteLength(out, end, literalLength - LZ_LENGTH_MASK);
+    if (!out) return NULL;
+  }
+  if ((size_t)(end - out) < literalLength) return NULL;
+  memcpy(out, literals, literalLength);
+  out += literalLength;
+  if (!matchLength) return out;
+
+  if (end - out < 2) return NULL;
+  *out++ = (unsigned char)(offset & 0xff);
+  *out++ = (unsigned char)(offset >> 8);
+  if (matchCode == LZ_LENGTH_MASK)
+    out = WriteLength(out, end, matchExtra - LZ_LENGTH_MASK);
+  return out;
+}
+
+static bool ReadLength(const unsigned char** in, const unsigned char* end,
+                       size_t* length)
+{
+  unsigned char byte;
+  do
+  {
+    if (*in >= end) return false;
+    byte = *(*in)++;
+    *length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+size_t LzCompressBound(const size_t size) { return size + size / 255 + 16; }
+
+size_t LzCompress(const void* src, const size_t size, void* dst,
+                  const size_t dstCapacity)
+{
+  const unsigned char* in = src;
+  unsigned char* out = dst;
+  const unsigned char* outEnd = out + dstCapacity;
+
+  // Last position each hashed 4 byte sequence was seen at
+  int table[1 << LZ_HASH_BITS];
+  memset(table, -1, sizeof(table));
+
+  size_t anchor = 0;
+  size_t position = 0;
+  while (position + LZ_MIN_MATCH <= size)
+  {
+    const uint32_t sequence = Read32(in + position);
+    const uint32_t hash = HashSequence(sequence);
+    const int candidate = table[hash];
+    table[hash] = (int)position;
+    if (candidate < 0 || position - (size_t)candidate > LZ_MAX_OFFSET ||
+        Read32(in + candidate) != sequence)
+    {
+      position++;
+      continue;
+    }
+
+    size_t matchLength = LZ_MIN_MATCH;
+    while (position + matchLength < size &&
+           in[candidate + matchLength] == in[position + matchLength])
+      matchLength++;
+
+    out = WriteSequence(out, outEnd, in + anchor, position - anchor,
+                        position - (size_t)candidate, matchLength);
+    if (!out) return 0;
+    position += matchLength;
+    anchor = position;
+  }
+
+  out = WriteSequence(out, outEnd, in + anchor, size - anchor, 0, 0);
+  if (!out) return 0;
+  return (size_t)(out - (unsigned char*)dst);
+}
+
+bool LzDecompress(const void* src, const size_t srcSize, void* dst,
+                  const size_t dstSize)
+{
+  const unsigned char* in = src;
+  const unsigned char* inEnd = in + srcSize;
+  unsigned char* out = dst;
+  const unsigned char* outEnd = out + dstSize;
+
+  while (in < inEnd)
+  {
+    const unsigned char token = *in++;
+
+    size_t literalLength = token >> 4;
+    if (literalLength == LZ_LENGTH_MASK &&
+        !ReadLength(&in, inEnd, &literalLength))
+      return false;
+    if ((size_t)(inEnd - in) < literalLength ||
+        (size_t)(outEnd - out) < literalLength)
+      return false;
+    memcpy(out, in, literalLength);
+    in += literalLength;
+    out += literalLength;
+
+    // Only the last sequence ends right after its literals
+    if (in == inEnd) break;
+
+    if (inEnd - in < 2) return false;
+    const size_t offset = (size_t)in[0] | (size_t)in[1] << 8;
+    in += 2;
+    if (offset == 0 || offset > (size_t)(out - (unsigned char*)dst))
+      return false;
+
+    size_t matchLength = (token & LZ_LENGTH_MASK) + LZ_MIN_MATCH;
+    if ((token & LZ_LENGTH_MASK) == LZ_LENGTH_MASK &&
+        !ReadLength(&in, inEnd, &matchLength))
+      return false;
+    if ((size_t)(outEnd - out) < matchLength) return false;
+
+    // Matches may overlap what they're writing, runs copy one byte at a time
+    const unsigned char* match = out - offset;
+    if (offset >= matchLength)
+      memcpy(out, match, matchLength);
+    else
+    {
+      for (size_t i = 0; i < matchLength; i++)
+        out[i] = match[i];
+    }
+    out += matchLength;
+  }
+  return out == outEnd;
+}
@@ -0,0 +1,48 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Small LZ77 byte compressor for voxel payloads. Sequences are a token byte
+// holding the literal and match lengths (4 bits each, 15 meaning more length
+// bytes follow), the literals, then a 16 bit match offset. The last sequence
+// is literals only. Voxel data is mostly long runs of the same few bytes, so
+// this gets most of what a real codec would at a fraction of the cost.
+
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Worst case compressed size of size bytes */
+size_t LzCompressBound(size_t size);
+
+/* Compress size bytes of src into dst, returns the compressed size or 0 if
+ * dstCapacity is too small */
+size_t LzCompress(const void* src, size_t size, void* dst, size_t dstCapacity);
+
+/* Decompress into exactly dstSize bytes, returns false on corrupt input */
+bool LzDecompress(const void* src, size_t srcSize, void* dst, size_t dstSize);
+
+#endif // COMPRESSION_H
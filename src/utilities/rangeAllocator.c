@@ -0,0 +1,186 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "rangeAllocator.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct FreeRange
+{
+  int offset;
+  int size;
+} FreeRange;
+
+struct RangeAllocator
+{
+  FreeRange* ranges; // Sorted by offset, never touching each other
+  int rangeCount;
+  int rangeCapacity;
+  int capacity;
+  int used;
+};
+
+RangeAllocator* RangeAllocatorCreate(const int capacity)
+{
+  RangeAllocator* allocator = malloc(sizeof(RangeAllocator));
+  if (!allocator) return NULL;
+
+  allocator->rangeCapacity = 8;
+  allocator->ranges = malloc(allocator->rangeCapacity * sizeof(FreeRange));
+  if (!allocator->ranges)
+  {
+    free(allocator);
+    return NULL;
+  }
+  allocator->ranges[0] = (FreeRange){0, capacity};
+  allocator->rangeCount = capacity > 0 ? 1 : 0;
+  allocator->capacity = capacity;
+  allocator->used = 0;
+  return allocator;
+}
+
+void RangeAllocatorDestroy(RangeAllocator* allocator)
+{
+  if (!allocator) return;
+  free(allocator->ranges);
+  free(allocator);
+}
+
+int RangeAllocate(RangeAllocator* allocator, const int size)
+{
+  if (size <= 0) return -1;
+
+  for (int i = 0; i < allocator->rangeCount; i++)
+  {
+    FreeRange* range = &allocator->ranges[i];
+    if (range->size < size) continue;
+
+    const int offset = range->offset;
+    range->offset += size;
+    range->size -= size;
+    if (range->size == 0)
+    {
+      memmove(range, range + 1,
+              (allocator->rangeCount - i - 1) * sizeof(FreeRange));
+      allocator->rangeCount--;
+    }
+    allocator->used += size;
+    return offset;
+  }
+  return -1;
+}
+
+void RangeRelease(RangeAllocator* allocator, const int offset, const int size)
+{
+  if (size <= 0) return;
+
+  // First free range past the released one
+  int low = 0;
+  int high = allocator->rangeCount;
+  while (low < high)
+  {
+    const int middle = (low + high) / 2;
+    if (allocator->ranges[middle].offset < offset)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  FreeRange* previous = low > 0 ? &allocator->ranges[low - 1] : NULL;
+  FreeRange* next =
+    low < allocator->rangeCount ? &allocator->ranges[low] : NULL;
+  if ((previous && previous->offset + previous->size > offset) ||
+      (next && offset + size > next->offset))
+  {
+    fprintf(stderr, "Released range %d+%d overlaps a free range\n", offset,
+            size);
+    return;
+  }
+  allocator->used -= size;
+
+  // Merge with the neighbors it touches, otherwise insert it between them
+  const bool joinsPrevious =
+    previous && previous->offset + previous->size == offset;
+  const bool joinsNext = next && offset + size == next->offset;
+  if (joinsPrevious && joinsNext)
+  {
+    previous->size += size + next->size;
+    memmove(next, next + 1,
+            (allocator->rangeCount - low - 1) * sizeof(FreeRange));
+    allocator->rangeCount--;
+    return;
+  }
+  if (joinsPrevious)
+  {
+    previous->size += size;
+    return;
+  }
+  if (joinsNext)
+  {
+    next->offset = offset;
+    next->size += size;
+    return;
+  }
+
+  if (allocator->rangeCount == allocator->rangeCapacity)
+  {
+    const int newCapacity = allocator->rangeCapacity * 2;
+    FreeRange* ranges =
+      realloc(allocator->ranges, newCapacity * sizeof(FreeRange));
+    if (!ranges)
+    {
+      // The range is lost until the allocator is destroyed, which only wastes
+      // space, everything handed out stays valid
+      fprintf(stderr, "Failed to grow free ranges\n");
+      return;
+    }
+    allocator->ranges = ranges;
+    allocator->rangeCapacity = newCapacity;
+  }
+  memmove(&allocator->ranges[low + 1], &allocator->ranges[low],
+          (allocator->rangeCount - low) * sizeof(FreeRange));
+  allocator->ranges[low] = (FreeRange){offset, size};
+  allocator->rangeCount++;
+}
+
+int RangeAllocatorEnd(const RangeAllocator* allocator)
+{
+  if (allocator->rangeCount == 0) return allocator->capacity;
+  const FreeRange* last = &allocator->ranges[allocator->rangeCount - 1];
+  return last->offset + last->size == allocator->capacity ? last->offset
+                                                         : allocator->capacity;
+}
+
+int RangeAllocatorUsed(const RangeAllocator* allocator)
+{
+  return allocator->used;
+}
+
+int RangeAllocatorCapacity(const RangeAllocator* allocator)
+{
+  return allocator->capacity;
+}
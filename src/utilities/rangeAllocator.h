@@ -0,0 +1,55 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Hands out ranges of a fixed size space, such as a GPU buffer, that is
+// managed somewhere else. Free ranges are kept sorted and merged with their
+// neighbors, and allocations take the lowest one that fits, so the space stays
+// packed towards its start. Not thread safe, nothing here touches the space
+// itself.
+
+#ifndef RANGE_ALLOCATOR_H
+#define RANGE_ALLOCATOR_H
+
+typedef struct RangeAllocator RangeAllocator;
+
+/* Create an allocator over [0, capacity). Returns NULL if it couldn't be
+ * allocated */
+RangeAllocator* RangeAllocatorCreate(int capacity);
+void RangeAllocatorDestroy(RangeAllocator* allocator);
+
+/* Offset of a free range of size units, or -1 if none is large enough */
+int RangeAllocate(RangeAllocator* allocator, int size);
+
+/* Give back a range returned by RangeAllocate, with the same size */
+void RangeRelease(RangeAllocator* allocator, int offset, int size);
+
+/* End of the last range in use, everything past it is free */
+int RangeAllocatorEnd(const RangeAllocator* allocator);
+
+/* Units in use over every range */
+int RangeAllocatorUsed(const RangeAllocator* allocator);
+int RangeAllocatorCapacity(const RangeAllocator* allocator);
+
+#endif // RANGE_ALLOCATOR_H
@@ -0,0 +1,302 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Note: tinycthread pulls in windows.h on Windows, which clashes with raylib,
+// so this file must not include raylib.h (or anything that includes it).
+
+#include "slabAllocator.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tinycthread.h"
+
+#define SLAB_BYTES (64 * 1024) // Target size of a slab's slots
+#define SLOT_ALIGNMENT 16
+
+typedef struct Slab Slab;
+
+// Sits in front of every slot, free slots also use it as their list link
+typedef union SlotHeader
+{
+  struct
+  {
+    Slab* slab;
+    union SlotHeader* nextFree;
+  } link;
+  unsigned char padding[SLOT_ALIGNMENT];
+} SlotHeader;
+
+// Links of a slab in one of the allocator's lists
+typedef struct SlabLinks
+{
+  Slab* previous;
+  Slab* next;
+} SlabLinks;
+
+typedef struct SlabList
+{
+  Slab* head;
+  Slab* tail;
+} SlabList;
+
+struct Slab
+{
+  SlabAllocator* owner;
+  SlabLinks all;       // Every slab, so they can all be freed
+  SlabLinks available; // Slabs with a free slot
+  bool isAvailable;
+  SlotHeader* freeSlots;
+  int usedSlots;
+  unsigned char* slots;
+};
+
+struct SlabAllocator
+{
+  mtx_t lock;
+  size_t slotStride; // Header plus the slot, rounded up to the alignment
+  int slotsPerSlab;
+  int retainedSlabs;
+  SlabList all;
+  // Partly used slabs sit at the front and empty ones at the back, so slots
+  // are handed out of the fullest slabs and empty ones can be let go of
+  SlabList available;
+  SlabAllocatorStats stats;
+};
+
+// Slab lists, the links are picked by offset so a slab can be in both
+
+static SlabLinks* Links(Slab* slab, const size_t offset)
+{
+  return (SlabLinks*)((unsigned char*)slab + offset);
+}
+
+static void ListRemove(SlabList* list, Slab* slab, const size_t offset)
+{
+  SlabLinks* links = Links(slab, offset);
+  if (links->previous)
+    Links(links->previous, offset)->next = links->next;
+  else
+    list->head = links->next;
+  if (links->next)
+    Links(links->next, offset)->previous = links->previous;
+  else
+    list->tail = links->previous;
+  links->previous = NULL;
+  links->next = NULL;
+}
+
+static void ListPushFront(SlabList* list, Slab* slab, const size_t offset)
+{
+  SlabLinks* links = Links(slab, offset);
+  links->previous = NULL;
+  links->next = list->head;
+  if (list->head)
+    Links(list->head, offset)->previous = slab;
+  else
+    list->tail = slab;
+  list->head = slab;
+}
+
+static void ListPushBack(SlabList* list, Slab* slab, const size_t offset)
+{
+  SlabLinks* links = Links(slab, offset);
+  links->next = NULL;
+  links->previous = list->tail;
+  if (list->tail)
+    Links(list->tail, offset)->next = slab;
+  else
+    list->head = slab;
+  list->tail = slab;
+}
+
+#define ALL_LINKS offsetof(Slab, all)
+#define AVAILABLE_LINKS offsetof(Slab, available)
+
+// Slabs
+
+static Slab* CreateSlab(SlabAllocator* allocator)
+{
+  Slab* slab = calloc(1, sizeof(Slab));
+  if (!slab) return NULL;
+  slab->slots = malloc(allocator->slotStride * allocator->slotsPerSlab);
+  if (!slab->slots)
+  {
+    free(slab);
+    return NULL;
+  }
+
+  slab->owner = allocator;
+  for (int i = allocator->slotsPerSlab - 1; i >= 0; i--)
+  {
+    SlotHeader* header =
+      (SlotHeader*)(slab->slots + (size_t)i * allocator->slotStride);
+    header->link.slab = slab;
+    header->link.nextFree = slab->freeSlots;
+    slab->freeSlots = header;
+  }
+
+  ListPushBack(&allocator->all, slab, ALL_LINKS);
+  ListPushBack(&allocator->available, slab, AVAILABLE_LINKS);
+  slab->isAvailable = true;
+  allocator->stats.slabCount++;
+  allocator->stats.emptySlabCount++;
+  allocator->stats.slotCapacity += allocator->slotsPerSlab;
+  return slab;
+}
+
+static void DestroySlab(SlabAllocator* allocator, Slab* slab)
+{
+  ListRemove(&allocator->all, slab, ALL_LINKS);
+  if (slab->isAvailable)
+    ListRemove(&allocator->available, slab, AVAILABLE_LINKS);
+  if (slab->usedSlots == 0) allocator->stats.emptySlabCount--;
+  allocator->stats.slabCount--;
+  allocator->stats.slotCapacity -= allocator->slotsPerSlab;
+  allocator->stats.usedSlots -= slab->usedSlots;
+  free(slab->slots);
+  free(slab);
+}
+
+// Frees empty slabs from the back of the list until the retention is met
+static void TrimEmptySlabs(SlabAllocator* allocator)
+{
+  while (allocator->stats.emptySlabCount > allocator->retainedSlabs)
+  {
+    Slab* slab = allocator->available.tail;
+    if (!slab || slab->usedSlots != 0) break;
+    DestroySlab(allocator, slab);
+  }
+}
+
+// Allocator
+
+SlabAllocator* SlabAllocatorCreate(const size_t slotSize,
+                                   const int retainedSlabs)
+{
+  if (slotSize == 0) return NULL;
+
+  SlabAllocator* allocator = calloc(1, sizeof(SlabAllocator));
+  if (!allocator) return NULL;
+  if (mtx_init(&allocator->lock, mtx_plain) != thrd_success)
+  {
+    free(allocator);
+    return NULL;
+  }
+
+  allocator->slotStride = (sizeof(SlotHeader) + slotSize + SLOT_ALIGNMENT - 1) /
+                          SLOT_ALIGNMENT * SLOT_ALIGNMENT;
+  allocator->slotsPerSlab = (int)(SLAB_BYTES / allocator->slotStride);
+  if (allocator->slotsPerSlab < 1) allocator->slotsPerSlab = 1;
+  allocator->retainedSlabs = retainedSlabs > 0 ? retainedSlabs : 0;
+  allocator->stats.slotSize = slotSize;
+  return allocator;
+}
+
+void SlabAllocatorDestroy(SlabAllocator* allocator)
+{
+  if (!allocator) return;
+
+  while (allocator->all.head) DestroySlab(allocator, allocator->all.head);
+  mtx_destroy(&allocator->lock);
+  free(allocator);
+}
+
+void* SlabAllocate(SlabAllocator* allocator)
+{
+  mtx_lock(&allocator->lock);
+  Slab* slab = allocator->available.head;
+  if (!slab && !(slab = CreateSlab(allocator)))
+  {
+    mtx_unlock(&allocator->lock);
+    return NULL;
+  }
+
+  SlotHeader* header = slab->freeSlots;
+  slab->freeSlots = header->link.nextFree;
+  if (slab->usedSlots++ == 0)
+  {
+    // Partly used now, move it in front of the empty slabs
+    allocator->stats.emptySlabCount--;
+    ListRemove(&allocator->available, slab, AVAILABLE_LINKS);
+    ListPushFront(&allocator->available, slab, AVAILABLE_LINKS);
+  }
+  if (!slab->freeSlots)
+  {
+    ListRemove(&allocator->available, slab, AVAILABLE_LINKS);
+    slab->isAvailable = false;
+  }
+  allocator->stats.usedSlots++;
+  mtx_unlock(&allocator->lock);
+
+  header->link.nextFree = NULL;
+  void* slot = header + 1;
+  memset(slot, 0, allocator->stats.slotSize);
+  return slot;
+}
+
+void SlabFree(void* slot)
+{
+  if (!slot) return;
+
+  SlotHeader* header = (SlotHeader*)slot - 1;
+  Slab* slab = header->link.slab;
+  SlabAllocator* allocator = slab->owner;
+
+  mtx_lock(&allocator->lock);
+  header->link.nextFree = slab->freeSlots;
+  slab->freeSlots = header;
+  if (!slab->isAvailable)
+  {
+    ListPushFront(&allocator->available, slab, AVAILABLE_LINKS);
+    slab->isAvailable = true;
+  }
+  allocator->stats.usedSlots--;
+  if (--slab->usedSlots == 0)
+  {
+    // Empty slabs wait at the back until they're needed or trimmed
+    allocator->stats.emptySlabCount++;
+    ListRemove(&allocator->available, slab, AVAILABLE_LINKS);
+    ListPushBack(&allocator->available, slab, AVAILABLE_LINKS);
+    TrimEmptySlabs(allocator);
+  }
+  mtx_unlock(&allocator->lock);
+}
+
+void SlabAllocatorSetRetention(SlabAllocator* allocator,
+                               const int retainedSlabs)
+{
+  mtx_lock(&allocator->lock);
+  allocator->retainedSlabs = retainedSlabs > 0 ? retainedSlabs : 0;
+  TrimEmptySlabs(allocator);
+  mtx_unlock(&allocator->lock);
+}
+
+SlabAllocatorStats SlabAllocatorGetStats(SlabAllocator* allocator)
+{
+  mtx_lock(&allocator->lock);
+  const SlabAllocatorStats stats = allocator->stats;
+  mtx_unlock(&allocator->lock);
+  return stats;
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Fixed size slots carved out of larger slabs, for memory that comes and goes
+// at a high rate in a few sizes. Every slot remembers its slab, so freeing is
+// O(1). Slabs that empty out are kept up to a retention limit, and only freed
+// past it, so a working set that shrinks and grows again doesn't go back to
+// the system allocator every time. Safe to use from any thread.
+
+#ifndef SLAB_ALLOCATOR_H
+#define SLAB_ALLOCATOR_H
+
+#include <stddef.h>
+
+typedef struct SlabAllocator SlabAllocator;
+
+typedef struct SlabAllocatorStats
+{
+  size_t slotSize;    // Bytes handed out per slot
+  int slabCount;      // Slabs allocated, empty ones included
+  int emptySlabCount; // Slabs kept around without any slot in use
+  int usedSlots;
+  int slotCapacity; // Slots over every slab
+} SlabAllocatorStats;
+
+/* Create an allocator of slotSize byte slots, keeping at most retainedSlabs
+ * empty slabs. Returns NULL if it couldn't be allocated */
+SlabAllocator* SlabAllocatorCreate(size_t slotSize, int retainedSlabs);
+
+/* Free the allocator and every slab, slots still in use included */
+void SlabAllocatorDestroy(SlabAllocator* allocator);
+
+/* A zeroed slot, or NULL if a new slab couldn't be allocated */
+void* SlabAllocate(SlabAllocator* allocator);
+
+/* Give a slot back to the allocator it came from, NULL is ignored */
+void SlabFree(void* slot);
+
+/* Change how many empty slabs are kept, freeing any past the new limit */
+void SlabAllocatorSetRetention(SlabAllocator* allocator, int retainedSlabs);
+
+SlabAllocatorStats SlabAllocatorGetStats(SlabAllocator* allocator);
+
+#endif // SLAB_ALLOCATOR_H
@@ -0,0 +1,266 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Open addressing hash map from chunk coordinates to chunks. Entries live in a
+// single array and use Robin Hood probing, so a lookup is a hash and a short
+// linear scan with no allocations, function pointers or copies.
+
+#ifndef CHUNK_HASH_MAP_H
+#define CHUNK_HASH_MAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "dataTypes.h"
+
+#define CHUNK_HASH_MAP_INITIAL_CAPACITY 64
+// Grow once the map is 7/8 full, Robin Hood keeps probes short up to there
+#define CHUNK_HASH_MAP_MAX_LOAD_NUMERATOR 7
+#define CHUNK_HASH_MAP_MAX_LOAD_DENOMINATOR 8
+
+typedef struct ChunkKey
+{
+  int chunkX;
+  int chunkY;
+  int chunkZ;
+} ChunkKey;
+
+typedef struct ChunkHashMapEntry
+{
+  ChunkKey key;
+  uint32_t distance; // Probe distance plus one, 0 marks an empty slot
+  Chunk* chunk;
+} ChunkHashMapEntry;
+
+typedef struct ChunkHashMap
+{
+  ChunkHashMapEntry* entries;
+  size_t capacity; // Always a power of two
+  size_t size;
+  size_t mask; // capacity - 1 for fast modulo
+} ChunkHashMap;
+
+// Multiplies each axis by its own odd constant so neighboring chunks don't
+// collide, then runs a murmur3 style finalizer to spread the bits
+static inline uint32_t ChunkKeyHash(const ChunkKey key)
+{
+  uint32_t hash = (uint32_t)key.chunkX * 0x8DA6B343u ^
+                  (uint32_t)key.chunkY * 0xD8163841u ^
+                  (uint32_t)key.chunkZ * 0xCB1AB31Fu;
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6Bu;
+  hash ^= hash >> 13;
+  hash *= 0xC2B2AE35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+static inline bool ChunkKeyEquals(const ChunkKey key1, const ChunkKey key2)
+{
+  return key1.chunkX == key2.chunkX && key1.chunkY == key2.chunkY &&
+         key1.chunkZ == key2.chunkZ;
+}
+
+static ChunkHashMap* ChunkHashMapCreate(const size_t initialCapacity)
+{
+  size_t capacity = CHUNK_HASH_MAP_INITIAL_CAPACITY;
+  while (capacity < initialCapacity)
+    capacity *= 2;
+
+  ChunkHashMap* map = malloc(sizeof(ChunkHashMap));
+  if (!map) return NULL;
+  map->entries = calloc(capacity, sizeof(ChunkHashMapEntry));
+  if (!map->entries)
+  {
+    free(map);
+    return NULL;
+  }
+  map->capacity = capacity;
+  map->size = 0;
+  map->mask = capacity - 1;
+  return map;
+}
+
+static void ChunkHashMapFree(ChunkHashMap* map)
+{
+  if (!map) return;
+  free(map->entries);
+  free(map);
+}
+
+// Places an entry known not to be in the map yet, taking slots from entries
+// that are closer to their home slot than the one being placed
+static void ChunkHashMapInsertEntry(ChunkHashMapEntry* entries,
+                                    const size_t mask, ChunkHashMapEntry entry)
+{
+  size_t index = ChunkKeyHash(entry.key) & mask;
+  entry.distance = 1;
+  for (;;)
+  {
+    ChunkHashMapEntry* slot = &entries[index];
+    if (slot->distance == 0)
+    {
+      *slot = entry;
+      return;
+    }
+    if (slot->distance < entry.distance)
+    {
+      const ChunkHashMapEntry displaced = *slot;
+      *slot = entry;
+      entry = displaced;
+    }
+    index = (index + 1) & mask;
+    entry.distance++;
+  }
+}
+
+static bool ChunkHashMapResize(ChunkHashMap* map, const size_t newCapacity)
+{
+  ChunkHashMapEntry* newEntries =
+    calloc(newCapacity, sizeof(ChunkHashMapEntry));
+  if (!newEntries) return false;
+  const size_t newMask = newCapacity - 1;
+  for (size_t i = 0; i < map->capacity; i++)
+  {
+    if (map->entries[i].distance)
+      ChunkHashMapInsertEntry(newEntries, newMask, map->entries[i]);
+  }
+  free(map->entries);
+  map->entries = newEntries;
+  map->capacity = newCapacity;
+  map->mask = newMask;
+  return true;
+}
+
+static inline ChunkHashMapEntry* ChunkHashMapFind(const ChunkHashMap* map,
+                                                  const ChunkKey key)
+{
+  size_t index = ChunkKeyHash(key) & map->mask;
+  for (uint32_t distance = 1;; distance++)
+  {
+    ChunkHashMapEntry* entry = &map->entries[index];
+    // Entries are ordered by probe distance, so once a slot is closer to home
+    // than the key would be, the key can't be further along
+    if (entry->distance < distance) return NULL;
+    if (ChunkKeyEquals(entry->key, key)) return entry;
+    index = (index + 1) & map->mask;
+  }
+}
+
+static inline Chunk* ChunkHashMapGet(const ChunkHashMap* map,
+                                     const ChunkKey key)
+{
+  if (!map) return NULL;
+  const ChunkHashMapEntry* entry = ChunkHashMapFind(map, key);
+  return entry ? entry->chunk : NULL;
+}
+
+// Adds or replaces the chunk stored under key
+static bool ChunkHashMapPut(ChunkHashMap* map, const ChunkKey key,
+                            Chunk* chunk)
+{
+  if (!map) return false;
+  ChunkHashMapEntry* existing = ChunkHashMapFind(map, key);
+  if (existing)
+  {
+    existing->chunk = chunk;
+    return true;
+  }
+
+  if ((map->size + 1) * CHUNK_HASH_MAP_MAX_LOAD_DENOMINATOR >
+      map->capacity * CHUNK_HASH_MAP_MAX_LOAD_NUMERATOR)
+  {
+    if (!ChunkHashMapResize(map, map->capacity * 2)) return false;
+  }
+
+  const ChunkHashMapEntry entry = {key, 0, chunk};
+  ChunkHashMapInsertEntry(map->entries, map->mask, entry);
+  map->size++;
+  return true;
+}
+
+// Removes key from the map, returning the chunk it held or NULL if missing
+static Chunk* ChunkHashMapRemove(ChunkHashMap* map, const ChunkKey key)
+{
+  if (!map) return NULL;
+  ChunkHashMapEntry* entry = ChunkHashMapFind(map, key);
+  if (!entry) return NULL;
+  Chunk* chunk = entry->chunk;
+
+  // Shift the following entries back a slot instead of leaving a tombstone
+  size_t index = (size_t)(entry - map->entries);
+  size_t next = (index + 1) & map->mask;
+  while (map->entries[next].distance > 1)
+  {
+    map->entries[index] = map->entries[next];
+    map->entries[index].distance--;
+    index = next;
+    next = (next + 1) & map->mask;
+  }
+  map->entries[index].distance = 0;
+  map->size--;
+  return chunk;
+}
+
+// Iterator interface for ChunkHashMap, the map must not be modified while
+// iterating
+typedef struct
+{
+  const ChunkHashMap* map;
+  size_t index;
+} ChunkHashMapIterator;
+
+static ChunkHashMapIterator ChunkHashMapIteratorCreate(const ChunkHashMap* map)
+{
+  const ChunkHashMapIterator it = {map, 0};
+  return it;
+}
+
+static bool ChunkHashMapIteratorNext(ChunkHashMapIterator* it,
+                                     ChunkKey* outKey, Chunk** outChunk)
+{
+  if (!it || !it->map) return false;
+  while (it->index < it->map->capacity)
+  {
+    const ChunkHashMapEntry* entry = &it->map->entries[it->index++];
+    if (!entry->distance) continue;
+    if (outKey) *outKey = entry->key;
+    if (outChunk) *outChunk = entry->chunk;
+    return true;
+  }
+  return false;
+}
+
+static size_t ChunkHashMapSize(const ChunkHashMap* map)
+{
+  return map ? map->size : 0;
+}
+
+static size_t ChunkHashMapCapacity(const ChunkHashMap* map)
+{
+  return map ? map->capacity : 0;
+}
+
+#endif // CHUNK_HASH_MAP_H
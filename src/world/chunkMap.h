@@ -26,43 +26,20 @@
 #ifndef CHUNK_MAP_H
 #define CHUNK_MAP_H
 
+#include "chunkColdTier.h"
+#include "chunkHashMap.h"
+#include "chunkMeshGeneration.h"
 #include "chunkPool.h"
+#include "chunkStorage.h"
 #include "dataTypes.h"
-#include "map.h"
-
-typedef struct ChunkKey
-{
-  int chunkX;
-  int chunkY;
-  int chunkZ;
-} ChunkKey;
-
-static size_t ChunkKeyHash(const void* key)
-{
-  const ChunkKey* chunkKey = key;
-  const size_t hashX = MapHashInt(&chunkKey->chunkX);
-  const size_t hashY = MapHashInt(&chunkKey->chunkY);
-  const size_t hashZ = MapHashInt(&chunkKey->chunkZ);
-  return hashX ^ hashY * 31 ^ hashZ * 31;
-}
-
-static bool ChunkKeyCompare(const void* key1, const void* key2)
-{
-  const ChunkKey* chunkKey = key1;
-  const ChunkKey* chunkKey2 = key2;
-  return chunkKey->chunkX == chunkKey2->chunkX &&
-         chunkKey->chunkY == chunkKey2->chunkY &&
-         chunkKey->chunkZ == chunkKey2->chunkZ;
-}
 
 // Global map instance for storing chunks
-extern Map* loadedChunks;
+extern ChunkHashMap* loadedChunks;
 
 // Initializes the chunk map
 static void InitializeChunkMap()
 {
-  loadedChunks =
-    MapCreate(sizeof(ChunkKey), sizeof(Chunk*), ChunkKeyHash, ChunkKeyCompare);
+  loadedChunks = ChunkHashMapCreate(CHUNK_HASH_MAP_INITIAL_CAPACITY);
 }
 
 static void AddChunkToMap(const int chunkX, const int chunkY, const int chunkZ,
@@ -75,7 +52,13 @@ static void AddChunkToMap(const int chunkX, const int chunkY, const int chunkZ,
   }
   if (!loadedChunks) InitializeChunkMap();
   const ChunkKey key = {chunkX, chunkY, chunkZ};
-  MapPut(loadedChunks, &key, &chunk);
+  ChunkHashMapPut(loadedChunks, key, chunk);
+}
+
+// Chunk holding a world voxel coordinate, rounding down for negative ones
+static int WorldToChunkCoord(const int voxel)
+{
+  return voxel >= 0 ? voxel / CHUNK_SIZE : (voxel + 1) / CHUNK_SIZE - 1;
 }
 
 static Chunk* GetChunkFromMap(const int chunkX, const int chunkY,
@@ -89,8 +72,16 @@ static Chunk* GetChunkFromMap(const int chunkX, const int chunkY,
     return NULL;
   }
   const ChunkKey key = {chunkX, chunkY, chunkZ};
-  Chunk* chunk = NULL;
-  return MapGet(loadedChunks, &key, &chunk) ? chunk : NULL;
+  return ChunkHashMapGet(loadedChunks, key);
+}
+
+// Unloads a chunk into the cold tier, which saves any changes to the region
+// files once it's evicted, or straight to them if the tier can't take it
+static void ReleaseLoadedChunk(Chunk* chunk)
+{
+  if (!ChunkColdTierStore(chunk) && chunk->unsaved) ChunkStorageSave(chunk);
+  UnloadChunkMesh(chunk);
+  ChunkPoolRelease(chunk);
 }
 
 static void RemoveChunkFromMap(const int chunkX, const int chunkY,
@@ -102,13 +93,8 @@ static void RemoveChunkFromMap(const int chunkX, const int chunkY,
     return;
   }
   const ChunkKey key = {chunkX, chunkY, chunkZ};
-  Chunk* chunk = NULL;
-  if (MapGet(loadedChunks, &key, &chunk))
-  {
-    if (chunk->model.meshCount > 0) { REMOVE_CHUNK_MODEL(chunk) }
-    ChunkPoolRelease(chunk);
-    MapRemove(loadedChunks, &key);
-  }
+  Chunk* chunk = ChunkHashMapRemove(loadedChunks, key);
+  if (chunk) ReleaseLoadedChunk(chunk);
 }
 
 // Clears the chunk map
@@ -120,17 +106,13 @@ static void ClearChunkMap()
     return;
   }
 
-  MapIterator it = MapIteratorCreate(loadedChunks);
-  ChunkKey key;
+  ChunkHashMapIterator it = ChunkHashMapIteratorCreate(loadedChunks);
   Chunk* chunk;
 
-  while (MapIteratorNext(&it, &key, &chunk))
-  {
-    if (chunk->model.meshCount > 0) { REMOVE_CHUNK_MODEL(chunk); }
-    ChunkPoolRelease(chunk);
-  }
+  while (ChunkHashMapIteratorNext(&it, NULL, &chunk))
+    ReleaseLoadedChunk(chunk);
 
-  MapFree(loadedChunks);
+  ChunkHashMapFree(loadedChunks);
   loadedChunks = NULL;
 }
 
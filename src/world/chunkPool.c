@@ -25,116 +25,251 @@
 
 #include "chunkPool.h"
 #include <stdlib.h>
+#include <string.h>
+#include "caveCulling.h"
+#include "chunkMeshGeneration.h"
+#include "chunkVoxels.h"
 
 #define CHUNK_POOL_BLOCK_SIZE 64
 
 typedef struct ChunkPoolBlock
 {
-  Chunk* chunks;               // contiguous block of chunks
-  int usageCount;              // number of chunks in use
-  struct ChunkPoolBlock* next; // linked list of blocks
+  Chunk* chunks;     // contiguous block of chunks
+  Chunk* freeChunks; // chunks of this block not in use
+  int usageCount;    // number of chunks in use
+  bool isAvailable;  // in the list of blocks with free chunks
+  // linked list of every block
+  struct ChunkPoolBlock* previous;
+  struct ChunkPoolBlock* next;
+  // linked list of blocks with free chunks
+  struct ChunkPoolBlock* previousAvailable;
+  struct ChunkPoolBlock* nextAvailable;
 } ChunkPoolBlock;
 
 static ChunkPoolBlock* poolBlocks = NULL;
-static Chunk* freeList = NULL;
+// Partly used blocks first and empty ones last, so chunks are handed out of
+// the fullest blocks and empty ones can be let go of
+static ChunkPoolBlock* availableBlocks = NULL;
+static ChunkPoolBlock* availableBlocksTail = NULL;
+static int retainedBlocks = POOL_RETAINED_BLOCKS;
+static ChunkPoolStats stats = {0};
+
+// Voxel memory, one slab allocator per index width
+static SlabAllocator* voxelSlabs[CHUNK_POOL_VOXEL_CLASSES] = {NULL};
+static size_t voxelClassSizes[CHUNK_POOL_VOXEL_CLASSES] = {0};
 
 void ChunkPoolInit(void)
 {
-  poolBlocks = NULL;
-  freeList = NULL;
+  if (voxelSlabs[0]) return;
+
+  for (int i = 0; i < CHUNK_POOL_VOXEL_CLASSES; i++)
+  {
+    voxelClassSizes[i] = ChunkVoxelsAllocationSize(1 << i);
+    voxelSlabs[i] = SlabAllocatorCreate(voxelClassSizes[i], retainedBlocks);
+    if (!voxelSlabs[i])
+      TraceLog(LOG_ERROR, "Failed to create voxel slab allocator");
+  }
+}
+
+// Blocks with free chunks
+
+static void UnlinkAvailableBlock(ChunkPoolBlock* block)
+{
+  if (block->previousAvailable)
+    block->previousAvailable->nextAvailable = block->nextAvailable;
+  else
+    availableBlocks = block->nextAvailable;
+  if (block->nextAvailable)
+    block->nextAvailable->previousAvailable = block->previousAvailable;
+  else
+    availableBlocksTail = block->previousAvailable;
+  block->previousAvailable = NULL;
+  block->nextAvailable = NULL;
+  block->isAvailable = false;
 }
 
-// Allocate a new block of chunks and add them to the free list
-static void ChunkPoolAllocateBlock(void)
+static void PushAvailableBlock(ChunkPoolBlock* block, const bool front)
 {
-  ChunkPoolBlock* block = malloc(sizeof(ChunkPoolBlock));
-  if (!block) { return; }
+  if (front)
+  {
+    block->previousAvailable = NULL;
+    block->nextAvailable = availableBlocks;
+    if (availableBlocks)
+      availableBlocks->previousAvailable = block;
+    else
+      availableBlocksTail = block;
+    availableBlocks = block;
+  }
+  else
+  {
+    block->nextAvailable = NULL;
+    block->previousAvailable = availableBlocksTail;
+    if (availableBlocksTail)
+      availableBlocksTail->nextAvailable = block;
+    else
+      availableBlocks = block;
+    availableBlocksTail = block;
+  }
+  block->isAvailable = true;
+}
+
+// Allocate a new block of chunks and make it available
+static ChunkPoolBlock* ChunkPoolAllocateBlock(void)
+{
+  ChunkPoolBlock* block = calloc(1, sizeof(ChunkPoolBlock));
+  if (!block) { return NULL; }
 
   block->chunks = malloc(CHUNK_POOL_BLOCK_SIZE * sizeof(Chunk));
   if (!block->chunks)
   {
     free(block);
-    return;
+    return NULL;
   }
-  block->usageCount = 0;
-  for (int i = 0; i < CHUNK_POOL_BLOCK_SIZE; i++)
+  for (int i = CHUNK_POOL_BLOCK_SIZE - 1; i >= 0; i--)
   {
     block->chunks[i].block = block;
-    block->chunks[i].voxels = NULL;
+    block->chunks[i].voxels = (ChunkVoxels){0};
     block->chunks[i].needsMeshing = false;
-    block->chunks[i].model = (Model){0};
-    block->chunks[i].nextFree = freeList;
-    freeList = &block->chunks[i];
+    memset(block->chunks[i].dirtyLayers, 0,
+           sizeof(block->chunks[i].dirtyLayers));
+    block->chunks[i].unsaved = false;
+    block->chunks[i].meshTicket = 0;
+    block->chunks[i].lodLevel = 0;
+    block->chunks[i].faceConnections = ALL_FACES_CONNECTED;
+    block->chunks[i].cullStamp = 0;
+    block->chunks[i].mesh = (ChunkGpuMesh){0};
+    block->chunks[i].naiveQuadCount = 0;
+    block->chunks[i].column = NULL;
+    block->chunks[i].nextFree = block->freeChunks;
+    block->freeChunks = &block->chunks[i];
   }
+
   block->next = poolBlocks;
+  if (poolBlocks) poolBlocks->previous = block;
   poolBlocks = block;
+  PushAvailableBlock(block, false);
+
+  stats.blockCount++;
+  stats.emptyBlockCount++;
+  stats.chunkCapacity += CHUNK_POOL_BLOCK_SIZE;
+  return block;
+}
+
+// Free an empty block completely, O(1) as it only unlinks itself
+static void FreeBlock(ChunkPoolBlock* block)
+{
+  if (block->isAvailable) UnlinkAvailableBlock(block);
+  if (block->previous)
+    block->previous->next = block->next;
+  else
+    poolBlocks = block->next;
+  if (block->next) block->next->previous = block->previous;
+
+  stats.blockCount--;
+  stats.emptyBlockCount--;
+  stats.chunkCapacity -= CHUNK_POOL_BLOCK_SIZE;
+  free(block->chunks);
+  free(block);
+}
+
+// Frees empty blocks from the back of the list until the retention is met
+static void TrimEmptyBlocks(void)
+{
+  while (stats.emptyBlockCount > retainedBlocks && availableBlocksTail &&
+         availableBlocksTail->usageCount == 0)
+  {
+    FreeBlock(availableBlocksTail);
+  }
 }
 
 Chunk* ChunkPoolAcquire(void)
 {
-  if (!freeList)
+  ChunkPoolBlock* block = availableBlocks;
+  if (!block)
   {
-    ChunkPoolAllocateBlock();
-    if (!freeList) return NULL; // allocation failure
+    block = ChunkPoolAllocateBlock();
+    if (!block) return NULL; // allocation failure
   }
-  Chunk* chunk = freeList;
-  freeList = chunk->nextFree;
+
+  Chunk* chunk = block->freeChunks;
+  block->freeChunks = chunk->nextFree;
   chunk->nextFree = NULL;
-  if (chunk->block) chunk->block->usageCount++;
+  if (block->usageCount++ == 0)
+  {
+    // Partly used now, move it in front of the empty blocks
+    stats.emptyBlockCount--;
+    UnlinkAvailableBlock(block);
+    PushAvailableBlock(block, true);
+  }
+  if (!block->freeChunks) UnlinkAvailableBlock(block);
+  stats.chunksInUse++;
   return chunk;
 }
 
-// Remove from freeList all chunks belonging to a given block
-static void RemoveBlockFromFreeList(const ChunkPoolBlock* block)
+void ChunkPoolRelease(Chunk* chunk)
 {
-  Chunk** current = &freeList;
-  while (*current)
+  if (!chunk) return;
+  ChunkPoolBlock* block = chunk->block;
+  UnloadChunkMesh(chunk); // While the position still finds its edit copy
+  chunk->position = (Vector3I){0};
+  chunk->meshTicket = 0;
+  memset(chunk->dirtyLayers, 0, sizeof(chunk->dirtyLayers));
+  chunk->lodLevel = 0;
+  chunk->faceConnections = ALL_FACES_CONNECTED;
+  chunk->column = NULL;
+  chunk->unsaved = false;
+  ChunkVoxelsFree(&chunk->voxels);
+
+  chunk->nextFree = block->freeChunks;
+  block->freeChunks = chunk;
+  if (!block->isAvailable) PushAvailableBlock(block, true);
+  stats.chunksInUse--;
+  if (--block->usageCount == 0)
   {
-    if ((*current)->block == block) { *current = (*current)->nextFree; }
-    else { current = &(*current)->nextFree; }
+    // Empty blocks wait at the back until they're needed or trimmed
+    stats.emptyBlockCount++;
+    UnlinkAvailableBlock(block);
+    PushAvailableBlock(block, false);
+    TrimEmptyBlocks();
   }
 }
 
-// If a block has zero usage, free it completely
-static void FreeBlock(ChunkPoolBlock* block)
+void* ChunkPoolAllocateVoxels(const size_t size)
 {
-  RemoveBlockFromFreeList(block);
-  ChunkPoolBlock** current = &poolBlocks;
-  while (*current)
+  for (int i = 0; i < CHUNK_POOL_VOXEL_CLASSES; i++)
   {
-    if (*current == block)
+    if (!voxelSlabs[i])
     {
-      *current = block->next;
-      break;
+      TraceLog(LOG_ERROR, "Voxel memory requested before ChunkPoolInit");
+      return NULL;
     }
-    current = &(*current)->next;
+    if (voxelClassSizes[i] >= size) return SlabAllocate(voxelSlabs[i]);
   }
-  free(block->chunks);
-  free(block);
+  TraceLog(LOG_ERROR, "No voxel size class fits %zu bytes", size);
+  return NULL;
 }
 
-void ChunkPoolRelease(Chunk* chunk)
+void ChunkPoolFreeVoxels(void* memory) { SlabFree(memory); }
+
+void ChunkPoolSetRetention(const int blocks)
 {
-  if (!chunk) return;
-  ChunkPoolBlock* block = chunk->block;
-  chunk->position = (Vector3I){0};
-  if (chunk->voxels)
-  {
-    free(chunk->voxels);
-    chunk->voxels = NULL;
-  }
-  if (chunk->model.meshCount > 0)
+  retainedBlocks = blocks > 0 ? blocks : 0;
+  TrimEmptyBlocks();
+  for (int i = 0; i < CHUNK_POOL_VOXEL_CLASSES; i++)
   {
-    UnloadModel(chunk->model);
-    chunk->model.meshCount = 0;
+    if (voxelSlabs[i]) SlabAllocatorSetRetention(voxelSlabs[i], blocks);
   }
-  chunk->nextFree = freeList;
-  freeList = chunk;
-  if (block)
+}
+
+ChunkPoolStats ChunkPoolGetStats(void)
+{
+  ChunkPoolStats result = stats;
+  for (int i = 0; i < CHUNK_POOL_VOXEL_CLASSES; i++)
   {
-    block->usageCount--;
-    if (block->usageCount == 0) FreeBlock(block);
+    if (voxelSlabs[i])
+      result.voxelClasses[i] = SlabAllocatorGetStats(voxelSlabs[i]);
   }
+  return result;
 }
 
 void ChunkPoolShutdown(void)
@@ -148,5 +283,13 @@ void ChunkPoolShutdown(void)
     block = next;
   }
   poolBlocks = NULL;
-  freeList = NULL;
+  availableBlocks = NULL;
+  availableBlocksTail = NULL;
+  stats = (ChunkPoolStats){0};
+
+  for (int i = 0; i < CHUNK_POOL_VOXEL_CLASSES; i++)
+  {
+    SlabAllocatorDestroy(voxelSlabs[i]);
+    voxelSlabs[i] = NULL;
+  }
 }
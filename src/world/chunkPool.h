@@ -23,12 +23,30 @@
 * THE SOFTWARE.
 *******************************************************************************/
 
+// Chunks come out of blocks of chunk headers, and their voxels out of slabs
+// sized for each voxel index width (see chunkVoxels), so streaming chunks in
+// and out doesn't go through malloc and free all the time. Empty blocks and
+// slabs are kept up to a retention limit before they're given back.
+// Chunk headers are main thread only, voxel memory is safe from any thread.
+
 #ifndef CHUNK_POOL_H
 #define CHUNK_POOL_H
 
 #include "dataTypes.h"
+#include "slabAllocator.h"
+
+#define CHUNK_POOL_VOXEL_CLASSES 4 // Index widths of 1, 2, 4 and 8 bits
 
-/* Initialize the chunk pool system */
+typedef struct ChunkPoolStats
+{
+  int blockCount;      // Blocks of chunk headers, empty ones included
+  int emptyBlockCount; // Blocks kept around without any chunk in use
+  int chunksInUse;
+  int chunkCapacity; // Chunk headers over every block
+  SlabAllocatorStats voxelClasses[CHUNK_POOL_VOXEL_CLASSES];
+} ChunkPoolStats;
+
+/* Initialize the chunk pool system, before any chunk or voxels are used */
 void ChunkPoolInit(void);
 
 /* Shutdown the pool and free all allocated memory */
@@ -40,4 +58,16 @@ Chunk *ChunkPoolAcquire(void);
 /* Release a Chunk back into the pool for reuse */
 void ChunkPoolRelease(Chunk *chunk);
 
-#endif // CHUNK_POOL_H
\ No newline at end of file
+/* Zeroed voxel memory of at least size bytes, from the smallest size class
+ * that fits. Returns NULL if there is none or it couldn't be allocated */
+void *ChunkPoolAllocateVoxels(size_t size);
+
+/* Give voxel memory back to the pool, NULL is ignored */
+void ChunkPoolFreeVoxels(void *memory);
+
+/* Change how many empty blocks, and empty slabs of each size, are kept */
+void ChunkPoolSetRetention(int retainedBlocks);
+
+ChunkPoolStats ChunkPoolGetStats(void);
+
+#endif // CHUNK_POOL_H
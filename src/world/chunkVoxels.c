@@ -0,0 +1,397 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "chunkVoxels.h"
+#include <stdint.h>
+#include <string.h>
+#include "chunkPool.h"
+
+#define PALETTE_CAPACITY(bits) (1 << (bits))
+#define INDICES_SIZE(bits) (CHUNK_VOLUME * (bits) / 8)
+
+// One allocation holds the counts, the palette and then the indices
+size_t ChunkVoxelsAllocationSize(const int bitsPerIndex)
+{
+  return PALETTE_CAPACITY(bitsPerIndex) * (sizeof(unsigned short) + 1) +
+         INDICES_SIZE(bitsPerIndex);
+}
+
+// Comes zeroed out of the chunk pool's slab for the index width
+static bool Allocate(ChunkVoxels* voxels, const int bits)
+{
+  unsigned char* memory =
+    ChunkPoolAllocateVoxels(ChunkVoxelsAllocationSize(bits));
+  if (!memory)
+  {
+    TraceLog(LOG_ERROR, "Failed to allocate chunk voxels");
+    return false;
+  }
+  voxels->counts = (unsigned short*)memory;
+  voxels->palette = memory + PALETTE_CAPACITY(bits) * sizeof(unsigned short);
+  voxels->indices = voxels->palette + PALETTE_CAPACITY(bits);
+  voxels->paletteSize = 0;
+  voxels->bitsPerIndex = (unsigned char)bits;
+  return true;
+}
+
+static int ReadIndex(const ChunkVoxels* voxels, const int index)
+{
+  const int bits = voxels->bitsPerIndex;
+  const int bit = index * bits;
+  return voxels->indices[bit >> 3] >> (bit & 7) & ((1 << bits) - 1);
+}
+
+static void WriteIndex(ChunkVoxels* voxels, const int index, const int entry)
+{
+  const int bits = voxels->bitsPerIndex;
+  const int bit = index * bits;
+  const int mask = ((1 << bits) - 1) << (bit & 7);
+  unsigned char* byte = &voxels->indices[bit >> 3];
+  *byte = (unsigned char)((*byte & ~mask) | entry << (bit & 7));
+}
+
+// Re-encodes the indices at a new width, keeping the palette as is
+static bool Widen(ChunkVoxels* voxels, const int bits)
+{
+  ChunkVoxels widened;
+  if (!Allocate(&widened, bits)) return false;
+
+  memcpy(widened.counts, voxels->counts,
+         voxels->paletteSize * sizeof(unsigned short));
+  memcpy(widened.palette, voxels->palette, voxels->paletteSize);
+  widened.paletteSize = voxels->paletteSize;
+  for (int i = 0; i < CHUNK_VOLUME; i++)
+    WriteIndex(&widened, i, ReadIndex(voxels, i));
+
+  ChunkVoxelsFree(voxels);
+  *voxels = widened;
+  return true;
+}
+
+// Palette entry holding type, reusing unused entries before adding new ones
+static int FindOrAddEntry(ChunkVoxels* voxels, const VoxelType type)
+{
+  int freeEntry = -1;
+  for (int i = 0; i < voxels->paletteSize; i++)
+  {
+    if (voxels->palette[i] == type) return i;
+    if (freeEntry < 0 && voxels->counts[i] == 0) freeEntry = i;
+  }
+
+  if (freeEntry >= 0)
+  {
+    voxels->palette[freeEntry] = (unsigned char)type;
+    return freeEntry;
+  }
+
+  if (voxels->paletteSize == PALETTE_CAPACITY(voxels->bitsPerIndex))
+  {
+    if (voxels->bitsPerIndex == CHUNK_VOXELS_MAX_BITS)
+    {
+      TraceLog(LOG_ERROR, "Chunk voxel palette is full");
+      return -1;
+    }
+    if (!Widen(voxels, voxels->bitsPerIndex * 2)) return -1;
+  }
+
+  const int entry = voxels->paletteSize++;
+  voxels->palette[entry] = (unsigned char)type;
+  voxels->counts[entry] = 0;
+  return entry;
+}
+
+bool ChunkVoxelsSet(ChunkVoxels* voxels, const int x, const int y, const int z,
+                    const VoxelType type)
+{
+  if (ChunkVoxelsIsUniform(voxels))
+  {
+    if (type == voxels->uniformType) return true;
+
+    // Every voxel starts out pointing at the old uniform type
+    const unsigned char uniformType = voxels->uniformType;
+    if (!Allocate(voxels, 1)) return false;
+    voxels->palette[0] = uniformType;
+    voxels->counts[0] = CHUNK_VOLUME;
+    voxels->paletteSize = 1;
+  }
+
+  const int index = VOXEL_INDEX(x, y, z);
+  const int oldEntry = ReadIndex(voxels, index);
+  if (voxels->palette[oldEntry] == type) return true;
+
+  const int entry = FindOrAddEntry(voxels, type);
+  if (entry < 0) return false;
+  voxels->counts[oldEntry]--;
+  voxels->counts[entry]++;
+  WriteIndex(voxels, index, entry);
+
+  // Edited back into a single type, e.g. the last block of a chunk broken
+  if (voxels->counts[entry] == CHUNK_VOLUME)
+  {
+    ChunkVoxelsFree(voxels);
+    voxels->uniformType = (unsigned char)type;
+  }
+  return true;
+}
+
+// Generated chunks are mostly long runs of a single type, so packing looks at
+// eight voxels at a time and only falls back to single voxels at edges
+static bool IsRunOfEight(const unsigned char* types)
+{
+  uint64_t group;
+  memcpy(&group, types, sizeof(group));
+  return group == types[0] * 0x0101010101010101ull;
+}
+
+bool ChunkVoxelsPack(ChunkVoxels* voxels, const unsigned char* types)
+{
+  ChunkVoxelsFree(voxels);
+
+  int typeCounts[256] = {0};
+  for (int i = 0; i < CHUNK_VOLUME; i += 8)
+  {
+    if (IsRunOfEight(&types[i]))
+    {
+      typeCounts[types[i]] += 8;
+      continue;
+    }
+    for (int j = 0; j < 8; j++)
+      typeCounts[types[i + j]]++;
+  }
+  int paletteSize = 0;
+  for (int type = 0; type < 256; type++)
+    paletteSize += typeCounts[type] > 0;
+  if (paletteSize == 1)
+  {
+    voxels->uniformType = types[0];
+    return true;
+  }
+
+  int bits = 1;
+  while (PALETTE_CAPACITY(bits) < paletteSize)
+    bits *= 2;
+  if (!Allocate(voxels, bits)) return false;
+
+  // Entries in type order, plus a byte of each entry repeated for runs
+  const int perByte = 8 / bits;
+  unsigned char entryOfType[256];
+  unsigned char runByteOfType[256];
+  for (int type = 0; type < 256; type++)
+  {
+    if (!typeCounts[type]) continue;
+    const int entry = voxels->paletteSize++;
+    voxels->palette[entry] = (unsigned char)type;
+    voxels->counts[entry] = (unsigned short)typeCounts[type];
+    entryOfType[type] = (unsigned char)entry;
+    unsigned int runByte = 0;
+    for (int j = 0; j < perByte; j++)
+      runByte |= (unsigned int)entry << (j * bits);
+    runByteOfType[type] = (unsigned char)runByte;
+  }
+
+  // Eight voxels always fill exactly bits bytes
+  for (int i = 0; i < CHUNK_VOLUME; i += 8)
+  {
+    unsigned char* out = &voxels->indices[i / 8 * bits];
+    if (IsRunOfEight(&types[i]))
+    {
+      memset(out, runByteOfType[types[i]], bits);
+      continue;
+    }
+    for (int j = 0; j < 8; j += perByte)
+    {
+      unsigned int byte = 0;
+      for (int k = 0; k < perByte; k++)
+        byte |= (unsigned int)entryOfType[types[i + j + k]] << (k * bits);
+      out[j / perByte] = (unsigned char)byte;
+    }
+  }
+  return true;
+}
+
+// Inlined with a constant width so each case unrolls into plain shifts
+static inline void DecodeRow(const unsigned char* palette,
+                             const unsigned char* indices, const int bits,
+                             unsigned char* out)
+{
+  const int perByte = 8 / bits;
+  const unsigned int mask = (1u << bits) - 1;
+  for (int x = 0; x < CHUNK_SIZE; x += perByte)
+  {
+    const unsigned int byte = indices[x / perByte];
+    for (int j = 0; j < perByte; j++)
+      out[x + j] = palette[byte >> (j * bits) & mask];
+  }
+}
+
+void ChunkVoxelsUnpackRow(const ChunkVoxels* voxels, const int y, const int z,
+                          unsigned char* out)
+{
+  const int bits = voxels->bitsPerIndex;
+  if (!bits)
+  {
+    memset(out, voxels->uniformType, CHUNK_SIZE);
+    return;
+  }
+
+  const unsigned char* palette = voxels->palette;
+  const unsigned char* indices =
+    &voxels->indices[VOXEL_INDEX(0, y, z) * bits / 8];
+  switch (bits)
+  {
+    case 1: DecodeRow(palette, indices, 1, out); break;
+    case 2: DecodeRow(palette, indices, 2, out); break;
+    case 4: DecodeRow(palette, indices, 4, out); break;
+    default: DecodeRow(palette, indices, 8, out); break;
+  }
+}
+
+int ChunkVoxelsCount(const ChunkVoxels* voxels, const VoxelType type)
+{
+  if (ChunkVoxelsIsUniform(voxels))
+    return type == voxels->uniformType ? CHUNK_VOLUME : 0;
+
+  int count = 0;
+  for (int i = 0; i < voxels->paletteSize; i++)
+  {
+    if (voxels->palette[i] == type) count += voxels->counts[i];
+  }
+  return count;
+}
+
+size_t ChunkVoxelsMemoryUsage(const ChunkVoxels* voxels)
+{
+  if (ChunkVoxelsIsUniform(voxels)) return 0;
+  return ChunkVoxelsAllocationSize(voxels->bitsPerIndex);
+}
+
+const unsigned char* ChunkVoxelsRawData(const ChunkVoxels* voxels,
+                                        size_t* size)
+{
+  if (ChunkVoxelsIsUniform(voxels))
+  {
+    *size = 0;
+    return NULL;
+  }
+  *size = ChunkVoxelsAllocationSize(voxels->bitsPerIndex);
+  return (const unsigned char*)voxels->counts;
+}
+
+unsigned char* ChunkVoxelsRawAllocate(ChunkVoxels* voxels,
+                                      const int bitsPerIndex,
+                                      const int paletteSize, size_t* size)
+{
+  if (bitsPerIndex != 1 && bitsPerIndex != 2 && bitsPerIndex != 4 &&
+      bitsPerIndex != 8)
+    return NULL;
+  if (paletteSize < 1 || paletteSize > PALETTE_CAPACITY(bitsPerIndex))
+    return NULL;
+
+  ChunkVoxelsFree(voxels);
+  if (!Allocate(voxels, bitsPerIndex)) return NULL;
+  voxels->paletteSize = (unsigned short)paletteSize;
+  *size = ChunkVoxelsAllocationSize(bitsPerIndex);
+  return (unsigned char*)voxels->counts;
+}
+
+// Indices equal to the entry, compared a word at a time against the entry
+// repeated. Each match leaves only the lowest bit of its index set, so the
+// bit count skips the steps that would add empty neighbours and sums its
+// per-byte counts once every 16 words, before they can overflow. Inlined per
+// width, so all of it unrolls
+static inline int CountEntry(const ChunkVoxels* voxels, const int bits,
+                             const int entry)
+{
+  const uint64_t lowBits = ~0ull / ((1 << bits) - 1);
+  const uint64_t repeated = entry * lowBits;
+  int count = 0;
+  for (int block = 0; block < INDICES_SIZE(bits); block += 16 * 8)
+  {
+    uint64_t byteCounts = 0;
+    for (int i = block; i < block + 16 * 8; i += sizeof(uint64_t))
+    {
+      uint64_t word;
+      memcpy(&word, voxels->indices + i, sizeof(word));
+      word ^= repeated;
+      for (int shift = 1; shift < bits; shift *= 2)
+        word |= word >> shift;
+      word = ~word & lowBits;
+      if (bits < 2) word -= word >> 1 & 0x5555555555555555ull;
+      if (bits < 4)
+        word = (word & 0x3333333333333333ull) +
+               (word >> 2 & 0x3333333333333333ull);
+      if (bits < 8) word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+      byteCounts += word;
+    }
+    const uint64_t pairCounts = (byteCounts & 0x00FF00FF00FF00FFull) +
+                                (byteCounts >> 8 & 0x00FF00FF00FF00FFull);
+    count += (int)(pairCounts * 0x0001000100010001ull >> 48);
+  }
+  return count;
+}
+
+bool ChunkVoxelsRawValidate(const ChunkVoxels* voxels)
+{
+  if (ChunkVoxelsIsUniform(voxels))
+    return voxels->uniformType < VOXEL_TYPE_COUNT;
+
+  // Edits rely on every type being valid and listed once
+  bool listed[VOXEL_TYPE_COUNT] = {false};
+  for (int i = 0; i < voxels->paletteSize; i++)
+  {
+    const int type = voxels->palette[i];
+    if (type >= VOXEL_TYPE_COUNT || listed[type]) return false;
+    listed[type] = true;
+  }
+
+  // and on the counts matching the indices. With a full palette every index
+  // is in range, so the last entry simply has whatever the others leave
+  const int bits = voxels->bitsPerIndex;
+  int total = 0;
+  for (int entry = 0; entry < voxels->paletteSize; entry++)
+  {
+    int count = CHUNK_VOLUME - total;
+    if (entry < PALETTE_CAPACITY(bits) - 1)
+    {
+      switch (bits)
+      {
+        case 1: count = CountEntry(voxels, 1, entry); break;
+        case 2: count = CountEntry(voxels, 2, entry); break;
+        case 4: count = CountEntry(voxels, 4, entry); break;
+        default: count = CountEntry(voxels, 8, entry); break;
+      }
+    }
+    if (count != voxels->counts[entry]) return false;
+    total += count;
+  }
+  // Indices past the palette match no entry, which leaves the total short
+  return total == CHUNK_VOLUME;
+}
+
+void ChunkVoxelsFree(ChunkVoxels* voxels)
+{
+  ChunkPoolFreeVoxels(voxels->counts);
+  *voxels = (ChunkVoxels){0};
+}
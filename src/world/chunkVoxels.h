@@ -0,0 +1,116 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Chunk voxels are stored as a small palette of the types in the chunk plus
+// one bit packed palette index per voxel. Indices start at 1 bit and double
+// in width whenever the palette outgrows them, so a chunk of 4 types takes
+// 1 KiB instead of the 16 KiB of a plain Voxel array. Chunks made of a single
+// type (all AIR, or solid stone underground) are uniform and own no memory.
+
+#ifndef CHUNK_VOXELS_H
+#define CHUNK_VOXELS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "dataTypes.h"
+#include "settings.h"
+
+#define CHUNK_VOLUME (CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE)
+#define CHUNK_VOXELS_MAX_BITS 8
+
+// True while every voxel has the same type, uniformType
+static inline bool ChunkVoxelsIsUniform(const ChunkVoxels* voxels)
+{
+  return voxels->bitsPerIndex == 0;
+}
+
+// True while the chunk holds nothing but AIR
+static inline bool ChunkVoxelsIsEmpty(const ChunkVoxels* voxels)
+{
+  return voxels->bitsPerIndex == 0 && voxels->uniformType == AIR;
+}
+
+// True while the chunk is filled with a single type other than AIR
+static inline bool ChunkVoxelsIsSolid(const ChunkVoxels* voxels)
+{
+  return voxels->bitsPerIndex == 0 && voxels->uniformType != AIR;
+}
+
+// Type of the voxel at a local position
+static inline VoxelType ChunkVoxelsGet(const ChunkVoxels* voxels, const int x,
+                                       const int y, const int z)
+{
+  const int bits = voxels->bitsPerIndex;
+  if (!bits) return (VoxelType)voxels->uniformType;
+  // Widths divide 8, so an index never straddles two bytes
+  const int bit = VOXEL_INDEX(x, y, z) * bits;
+  const int entry = voxels->indices[bit >> 3] >> (bit & 7) & ((1 << bits) - 1);
+  return (VoxelType)voxels->palette[entry];
+}
+
+/* Change a single voxel, widening the indices if the palette needs to grow.
+ * Uniform chunks get their indices on the first edit that breaks them up, and
+ * chunks edited back into a single type become uniform again.
+ * Returns false if memory for that couldn't be allocated */
+bool ChunkVoxelsSet(ChunkVoxels* voxels, int x, int y, int z, VoxelType type);
+
+/* Replace every voxel from CHUNK_VOLUME types laid out like VOXEL_INDEX,
+ * picking the narrowest index width that fits, or none for a single type */
+bool ChunkVoxelsPack(ChunkVoxels* voxels, const unsigned char* types);
+
+/* Decode the CHUNK_SIZE voxels of the row at (y, z) into out */
+void ChunkVoxelsUnpackRow(const ChunkVoxels* voxels, int y, int z,
+                          unsigned char* out);
+
+/* Number of voxels of the given type */
+int ChunkVoxelsCount(const ChunkVoxels* voxels, VoxelType type);
+
+/* Bytes of the single allocation behind a chunk with the given index width */
+size_t ChunkVoxelsAllocationSize(int bitsPerIndex);
+
+/* Bytes allocated for the voxels */
+size_t ChunkVoxelsMemoryUsage(const ChunkVoxels* voxels);
+
+/* The single allocation behind a chunk that isn't uniform, holding its counts,
+ * palette and indices, so it can be stored and restored byte for byte.
+ * Returns NULL while uniform */
+const unsigned char* ChunkVoxelsRawData(const ChunkVoxels* voxels,
+                                        size_t* size);
+
+/* Replace the voxels with a zeroed allocation of the given layout for raw data
+ * to be written straight into. Returns NULL if the layout is invalid or the
+ * memory couldn't be allocated */
+unsigned char* ChunkVoxelsRawAllocate(ChunkVoxels* voxels, int bitsPerIndex,
+                                      int paletteSize, size_t* size);
+
+/* Check of restored raw data, or a restored uniform type: every type must be
+ * a valid VoxelType listed once, every index must point into the palette and
+ * the counts must match the indices */
+bool ChunkVoxelsRawValidate(const ChunkVoxels* voxels);
+
+/* Free the voxels, leaving an empty (all AIR) chunk */
+void ChunkVoxelsFree(ChunkVoxels* voxels);
+
+#endif // CHUNK_VOXELS_H
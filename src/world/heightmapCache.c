@@ -0,0 +1,182 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Note: tinycthread pulls in windows.h on Windows, which clashes with raylib,
+// so this file must not include raylib.h (or anything that includes it).
+
+#include "heightmapCache.h"
+#include <stdlib.h>
+#include "map.h"
+#include "tinycthread.h"
+
+typedef struct ColumnKey
+{
+  int chunkX;
+  int chunkZ;
+} ColumnKey;
+
+struct HeightmapColumn
+{
+  ColumnKey key;
+  int users;   // Acquires not yet released, main thread only
+  bool filled; // Guarded by lock
+  mtx_t lock;
+  Heightmap heightmap;
+};
+
+static Map* columns = NULL;
+static HeightmapCacheStats stats = {0};
+
+// Columns further than radius from the center are freed once unused
+static ColumnKey center = {0, 0};
+static int radius = -1; // Nothing is evicted before the first radius is set
+
+static size_t ColumnKeyHash(const void* key)
+{
+  const ColumnKey* column = key;
+  uint32_t hash = (uint32_t)column->chunkX * 0x8da6b343u ^
+                  (uint32_t)column->chunkZ * 0xcb1ab31fu;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+static bool ColumnKeyEquals(const void* a, const void* b)
+{
+  const ColumnKey* first = a;
+  const ColumnKey* second = b;
+  return first->chunkX == second->chunkX && first->chunkZ == second->chunkZ;
+}
+
+static bool IsInRadius(const ColumnKey key)
+{
+  if (radius < 0) return true;
+  const int distanceX = key.chunkX - center.chunkX;
+  const int distanceZ = key.chunkZ - center.chunkZ;
+  return distanceX * distanceX + distanceZ * distanceZ <= radius * radius;
+}
+
+static void FreeColumn(HeightmapColumn* column)
+{
+  MapRemove(columns, &column->key);
+  mtx_destroy(&column->lock);
+  free(column);
+  stats.columnCount--;
+}
+
+HeightmapColumn* HeightmapCacheAcquire(const int chunkX, const int chunkZ)
+{
+  if (!columns)
+  {
+    columns = MapCreate(sizeof(ColumnKey), sizeof(HeightmapColumn*),
+                        ColumnKeyHash, ColumnKeyEquals);
+    if (!columns) return NULL;
+  }
+
+  const ColumnKey key = {chunkX, chunkZ};
+  HeightmapColumn* column;
+  if (MapGet(columns, &key, &column))
+  {
+    column->users++;
+    stats.hits++;
+    return column;
+  }
+
+  column = malloc(sizeof(HeightmapColumn));
+  if (!column) return NULL;
+  if (mtx_init(&column->lock, mtx_plain) != thrd_success)
+  {
+    free(column);
+    return NULL;
+  }
+  column->key = key;
+  column->users = 1;
+  column->filled = false;
+  if (!MapPut(columns, &key, &column))
+  {
+    mtx_destroy(&column->lock);
+    free(column);
+    return NULL;
+  }
+  stats.columnCount++;
+  stats.misses++;
+  return column;
+}
+
+void HeightmapCacheRelease(HeightmapColumn* column)
+{
+  if (!column) return;
+  column->users--;
+  if (column->users <= 0 && !IsInRadius(column->key)) FreeColumn(column);
+}
+
+void HeightmapCacheSetRadius(const int centerX, const int centerZ,
+                             const int newRadius)
+{
+  if (centerX == center.chunkX && centerZ == center.chunkZ &&
+      newRadius == radius)
+    return;
+  center = (ColumnKey){centerX, centerZ};
+  radius = newRadius;
+
+  // Freeing is safe mid iteration, the iterator has already moved past it
+  MapIterator it = MapIteratorCreate(columns);
+  ColumnKey key;
+  HeightmapColumn* column;
+  while (MapIteratorNext(&it, &key, &column))
+  {
+    if (column->users <= 0 && !IsInRadius(key)) FreeColumn(column);
+  }
+}
+
+void HeightmapCacheClear(void)
+{
+  MapIterator it = MapIteratorCreate(columns);
+  ColumnKey key;
+  HeightmapColumn* column;
+  while (MapIteratorNext(&it, &key, &column))
+  {
+    mtx_destroy(&column->lock);
+    free(column);
+  }
+  MapFree(columns);
+  columns = NULL;
+  stats.columnCount = 0;
+}
+
+HeightmapCacheStats HeightmapCacheGetStats(void) { return stats; }
+
+const Heightmap* HeightmapCacheResolve(HeightmapColumn* column,
+                                       const HeightmapFillFunction fill)
+{
+  // Other chunks of the column wait here while the first one fills it
+  mtx_lock(&column->lock);
+  if (!column->filled)
+  {
+    fill(column->key.chunkX, column->key.chunkZ, &column->heightmap);
+    column->filled = true;
+  }
+  mtx_unlock(&column->lock);
+  return &column->heightmap;
+}
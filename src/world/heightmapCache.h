@@ -0,0 +1,82 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Every chunk in a vertical column shares the same surface heights, so they
+// are generated once per (chunkX, chunkZ) and kept while the column is near
+// the player. Columns are created and released by the main thread, which
+// holds a reference for every chunk still generating in them. The heights
+// themselves are filled by whichever worker gets to the column first.
+//
+// Note: this file is shared with worker threads and pulls in tinycthread, so
+// it must stay free of raylib.
+
+#ifndef HEIGHTMAP_CACHE_H
+#define HEIGHTMAP_CACHE_H
+
+#include <stdbool.h>
+#include "settings.h"
+
+typedef struct Heightmap
+{
+  short heights[CHUNK_SIZE][CHUNK_SIZE]; // World y of the surface, by [z][x]
+  short minHeight;
+  short maxHeight;
+} Heightmap;
+
+typedef struct HeightmapColumn HeightmapColumn;
+
+// Writes the heightmap of a column, called at most once per cached column
+typedef void (*HeightmapFillFunction)(int chunkX, int chunkZ, Heightmap* out);
+
+typedef struct HeightmapCacheStats
+{
+  int columnCount;  // Columns currently cached
+  long long hits;   // Chunk requests that found their column cached
+  long long misses; // Chunk requests that had to create it
+} HeightmapCacheStats;
+
+/* Main thread: get the column for a chunk about to generate, creating it if
+ * needed. Each acquire must be paired with a release */
+HeightmapColumn* HeightmapCacheAcquire(int chunkX, int chunkZ);
+
+/* Main thread: drop a reference. Unused columns outside the streaming radius
+ * are freed straight away, the rest stay cached */
+void HeightmapCacheRelease(HeightmapColumn* column);
+
+/* Main thread: move the streaming radius, freeing unused columns further
+ * than radius chunks from (centerX, centerZ) */
+void HeightmapCacheSetRadius(int centerX, int centerZ, int radius);
+
+/* Main thread: free every column, none may still be acquired */
+void HeightmapCacheClear(void);
+
+HeightmapCacheStats HeightmapCacheGetStats(void);
+
+/* Any thread holding the column through an acquire: its heights, filled
+ * with fill the first time they're needed */
+const Heightmap* HeightmapCacheResolve(HeightmapColumn* column,
+                                       HeightmapFillFunction fill);
+
+#endif // HEIGHTMAP_CACHE_H
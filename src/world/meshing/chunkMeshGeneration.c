@@ -25,195 +25,1013 @@
 
 #include "chunkMeshGeneration.h"
 #include <stdlib.h>
+#include <string.h>
+#include "caveCulling.h"
+#include "chunkBufferSizing.h"
 #include "chunkMap.h"
+#include "chunkRenderer.h"
+#include "chunkVoxels.h"
+#include "darray.h"
+#include "drawRegions.h"
+#include "jobSystem.h"
+#include "meshArena.h"
 #include "raylib.h"
 
-typedef struct
-{
-  Vector3 position;
-  Color color;
-} Vertex;
+#define INITIAL_QUAD_CAPACITY 256
+#define SPARE_MESH_JOBS 64 // Finished jobs kept for reuse
+#define MASK_INDEX(u, v) ((u) + CHUNK_SIZE * (v))
+#define MAX_VOTE_TYPES 8 // Distinct solid types counted when reducing a cell
+#define EDITED_MESH_SLOTS 32 // Meshes of recently edited chunks kept around
 
 typedef struct
 {
-  Vector3 vertices[6];
-  float shadeFactor;
-} FaceData;
-
-static const FaceData faces[6] = {
-  // TOP (+Y)
-  {{{0, 1, 0}, {0, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 1, 1}, {1, 1, 0}}, 1.0f},
-  // BOTTOM (-Y)
-  {{{0, 0, 0}, {1, 0, 0}, {1, 0, 1}, {0, 0, 0}, {1, 0, 1}, {0, 0, 1}}, 0.5f},
-  // LEFT (-X)
-  {{{0, 0, 0}, {0, 0, 1}, {0, 1, 1}, {0, 0, 0}, {0, 1, 1}, {0, 1, 0}}, 0.7f},
-  // RIGHT (+X)
-  {{{1, 0, 0}, {1, 1, 0}, {1, 1, 1}, {1, 0, 0}, {1, 1, 1}, {1, 0, 1}}, 0.75f},
-  // FRONT (+Z)
-  {{{0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 0, 1}, {1, 1, 1}, {0, 1, 1}}, 0.75f},
-  // BACK (-Z)
-  {{{0, 0, 0}, {0, 1, 0}, {1, 1, 0}, {0, 0, 0}, {1, 1, 0}, {1, 0, 0}}, 0.75f}};
-
-static const Color voxelColors[] = {
-  {0, 0, 0, 0},        // AIR = 0
-  {150, 75, 0, 255},   // DIRT = 1
-  {46, 125, 50, 255},  // GRASS = 2
-  {100, 100, 100, 255} // STONE = 3
+  ChunkMeshSnapshot snapshot;
+  MeshingMode mode;
+  ChunkMeshData data;
+} ChunkMeshJob;
+
+// Corners of each face, drawn as (0, 1, 2) (0, 2, 3)
+static const Vector3I faceCorners[6][4] = {
+  {{0, 1, 0}, {0, 1, 1}, {1, 1, 1}, {1, 1, 0}}, // TOP (+Y)
+  {{0, 0, 0}, {1, 0, 0}, {1, 0, 1}, {0, 0, 1}}, // BOTTOM (-Y)
+  {{0, 0, 0}, {0, 0, 1}, {0, 1, 1}, {0, 1, 0}}, // LEFT (-X)
+  {{1, 0, 0}, {1, 1, 0}, {1, 1, 1}, {1, 0, 1}}, // RIGHT (+X)
+  {{0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}}, // FRONT (+Z)
+  {{0, 0, 0}, {0, 1, 0}, {1, 1, 0}, {1, 0, 0}}  // BACK (-Z)
+};
+
+// Index offset to the neighboring voxel in a padded snapshot, by Face
+static const int neighborOffsets[6] = {
+  PADDED_CHUNK_SIZE,                      // TOP (+Y)
+  -PADDED_CHUNK_SIZE,                     // BOTTOM (-Y)
+  -1,                                     // LEFT (-X)
+  1,                                      // RIGHT (+X)
+  PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE,  // FRONT (+Z)
+  -PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE, // BACK (-Z)
 };
 
-static Color ApplyShading(const Color base, const float factor)
+// Copy of the last mesh of a recently edited chunk, in chunk coordinates,
+// so its next edit only has to mesh the layers it touched
+typedef struct EditedMesh
 {
-  return (Color){(unsigned char)((float)base.r * factor),
-                 (unsigned char)((float)base.g * factor),
-                 (unsigned char)((float)base.b * factor), base.a};
+  Vector3I position;
+  uint32_t* vertices; // NULL while the slot is free
+  ChunkMeshLayers layers;
+  unsigned int lastUse;
+} EditedMesh;
+
+// Meshes built by the workers, waiting for their turn to be uploaded
+static DArray* readyMeshes = NULL;
+static unsigned int nextMeshTicket = 1;
+
+// Jobs are allocated and finished on the main thread, so the snapshots they
+// carry are recycled there instead of going back to the heap every remesh
+static DArray* spareJobs = NULL;
+
+// Positions of chunks flagged for meshing, kept by key since a chunk may be
+// unloaded before its turn comes
+static DArray* dirtyChunks = NULL;
+
+// Totals over every uploaded chunk mesh
+static ChunkMeshStats meshStats = {0};
+
+// Edited chunks most likely to be edited again, the player tends to keep at
+// it in the same spot. Main thread only
+static EditedMesh editedMeshes[EDITED_MESH_SLOTS];
+static int editedMeshCount = 0;
+static unsigned int editedMeshClock = 0;
+
+// Where levels of detail are measured from, see SetChunkMeshLod
+static Vector3I lodCenter = {0, 0, 0};
+static int lodDistance = 0;
+
+// Maps a position on a face layer back to voxel space, layer runs along the
+// face normal. TOP/BOTTOM map (u, v) to (x, z), LEFT/RIGHT to (y, z) and
+// FRONT/BACK to (x, y)
+static void FaceToVoxel(const Face face, const int u, const int v,
+                        const int layer, int* x, int* y, int* z)
+{
+  switch (face)
+  {
+    case TOP:
+    case BOTTOM:
+      *x = u;
+      *y = layer;
+      *z = v;
+      break;
+    case LEFT:
+    case RIGHT:
+      *x = layer;
+      *y = u;
+      *z = v;
+      break;
+    default:
+      *x = u;
+      *y = v;
+      *z = layer;
+      break;
+  }
 }
 
-static bool IsFaceExposed(const Chunk* chunk, const int x, const int y,
-                          const int z, const Face face)
+int ChunkLodLevel(const Vector3I position, const Vector3I center,
+                  const int distance)
 {
-  int neighborX = x + (face == RIGHT) - (face == LEFT);
-  int neighborY = y + (face == TOP) - (face == BOTTOM);
-  int neighborZ = z + (face == FRONT) - (face == BACK);
+  if (distance <= 0) return 0;
 
-  // Check within current chunk bounds
-  if (neighborX >= 0 && neighborX < CHUNK_SIZE && neighborY >= 0 &&
-      neighborY < CHUNK_SIZE && neighborZ >= 0 && neighborZ < CHUNK_SIZE)
+  const long long x = position.x - center.x;
+  const long long y = position.y - center.y;
+  const long long z = position.z - center.z;
+  const long long lengthSq = x * x + y * y + z * z;
+  long long ring = distance;
+  int level = 0;
+  while (level < MAX_CHUNK_LOD && lengthSq > ring * ring)
   {
-    // If the current chunk’s voxel data is missing, it's all air
-    return chunk->voxels[VOXEL_INDEX(neighborX, neighborY, neighborZ)].type ==
-           AIR;
+    level++;
+    ring *= 2;
   }
+  return level;
+}
 
-  // Calculate neighbor chunk coordinates
-  const int chunkOffsetX = neighborX < 0 ? -1 : neighborX >= CHUNK_SIZE ? 1 : 0;
-  const int chunkOffsetY = neighborY < 0 ? -1 : neighborY >= CHUNK_SIZE ? 1 : 0;
-  const int chunkOffsetZ = neighborZ < 0 ? -1 : neighborZ >= CHUNK_SIZE ? 1 : 0;
+bool SetChunkMeshLod(const Vector3I center, const int distance)
+{
+  const bool moved = center.x != lodCenter.x || center.y != lodCenter.y ||
+                     center.z != lodCenter.z;
+  const bool changed = distance != lodDistance || (distance > 0 && moved);
+  lodCenter = center;
+  lodDistance = distance;
+  return changed;
+}
 
-  const Chunk* neighbor = GetChunkFromMap(chunk->position.x + chunkOffsetX,
-                                          chunk->position.y + chunkOffsetY,
-                                          chunk->position.z + chunkOffsetZ);
+void TakeChunkMeshSnapshot(const Chunk* chunk, ChunkMeshSnapshot* snapshot)
+{
+  snapshot->position = chunk->position;
+  snapshot->uniform = ChunkVoxelsIsUniform(&chunk->voxels);
+  snapshot->solidNeighbors = 0;
+  snapshot->lod =
+    (unsigned char)ChunkLodLevel(chunk->position, lodCenter, lodDistance);
+  snapshot->baseVertices = NULL;
+  snapshot->edited = false;
+  memset(snapshot->voxels, AIR, sizeof(snapshot->voxels));
 
-  if (!neighbor) return true;
+  // The chunk itself, one row at a time
+  for (int z = 0; z < CHUNK_SIZE; z++)
+  {
+    for (int y = 0; y < CHUNK_SIZE; y++)
+    {
+      ChunkVoxelsUnpackRow(&chunk->voxels, y, z,
+                           &snapshot->voxels[PADDED_INDEX(0, y, z)]);
+    }
+  }
 
-  // Wrap coordinates to neighbor chunk space
-  neighborX = (neighborX + CHUNK_SIZE) % CHUNK_SIZE;
-  neighborY = (neighborY + CHUNK_SIZE) % CHUNK_SIZE;
-  neighborZ = (neighborZ + CHUNK_SIZE) % CHUNK_SIZE;
+  // The layer of each neighbor touching this chunk goes into the border,
+  // unless the neighbor is meshed at another level of detail
+  for (Face face = 0; face < 6; face++)
+  {
+    const Vector3I position = {
+      chunk->position.x + (face == RIGHT) - (face == LEFT),
+      chunk->position.y + (face == TOP) - (face == BOTTOM),
+      chunk->position.z + (face == FRONT) - (face == BACK)};
+    const Chunk* neighbor = GetChunkFromMap(position.x, position.y, position.z);
+    if (!neighbor || ChunkVoxelsIsEmpty(&neighbor->voxels)) continue;
+    if (ChunkLodLevel(position, lodCenter, lodDistance) != snapshot->lod)
+      continue;
+    if (ChunkVoxelsIsSolid(&neighbor->voxels))
+      snapshot->solidNeighbors |= 1 << face;
+
+    const bool positive = face == TOP || face == RIGHT || face == FRONT;
+    const int layer = positive ? CHUNK_SIZE : -1;
+    const int neighborLayer = positive ? 0 : CHUNK_SIZE - 1;
+
+    // Slabs above, below, in front and behind are made of whole rows
+    if (face == TOP || face == BOTTOM)
+    {
+      for (int z = 0; z < CHUNK_SIZE; z++)
+        ChunkVoxelsUnpackRow(&neighbor->voxels, neighborLayer, z,
+                             &snapshot->voxels[PADDED_INDEX(0, layer, z)]);
+      continue;
+    }
+    if (face == FRONT || face == BACK)
+    {
+      for (int y = 0; y < CHUNK_SIZE; y++)
+        ChunkVoxelsUnpackRow(&neighbor->voxels, y, neighborLayer,
+                             &snapshot->voxels[PADDED_INDEX(0, y, layer)]);
+      continue;
+    }
 
-  if (!neighbor->voxels) return true;
-  return neighbor->voxels[VOXEL_INDEX(neighborX, neighborY, neighborZ)].type ==
-         AIR;
+    // Left and right slabs cut across the rows, one voxel at a time
+    for (int z = 0; z < CHUNK_SIZE; z++)
+    {
+      for (int y = 0; y < CHUNK_SIZE; y++)
+      {
+        snapshot->voxels[PADDED_INDEX(layer, y, z)] = (unsigned char)
+          ChunkVoxelsGet(&neighbor->voxels, neighborLayer, y, z);
+      }
+    }
+  }
 }
 
-void GenerateChunkMesh(Chunk* chunk)
+// Voxels of the snapshot a reduced cell covers along one axis. Cells past
+// either end are the border, which is a single layer of voxels
+static void CellVoxelRange(const int cell, const int size, const int scale,
+                           int* first, int* last)
 {
-  if (!chunk)
+  if (cell < 0 || cell >= size)
   {
-    TraceLog(LOG_ERROR, "Null chunk passed to mesh generation");
+    *first = *last = cell < 0 ? -1 : CHUNK_SIZE;
     return;
   }
+  *first = cell * scale;
+  *last = *first + scale - 1;
+}
+
+// Most common solid type among the voxels of a box, or AIR when more than
+// half of them are air. Ties go to solid so thin surfaces don't wear away
+static unsigned char MajorityType(const unsigned char* voxels,
+                                  const int first[3], const int last[3])
+{
+  unsigned char types[MAX_VOTE_TYPES];
+  int votes[MAX_VOTE_TYPES];
+  int typeCount = 0;
+  int solid = 0;
+  int total = 0;
 
-  // If no voxel data is allocated, the chunk is entirely AIR
-  if (!chunk->voxels)
+  for (int z = first[2]; z <= last[2]; z++)
   {
-    chunk->needsMeshing = false;
-    return;
+    for (int y = first[1]; y <= last[1]; y++)
+    {
+      for (int x = first[0]; x <= last[0]; x++)
+      {
+        const unsigned char type = voxels[PADDED_INDEX(x, y, z)];
+        total++;
+        if (type == AIR) continue;
+        solid++;
+
+        int i = 0;
+        while (i < typeCount && types[i] != type)
+          i++;
+        if (i == typeCount)
+        {
+          if (typeCount == MAX_VOTE_TYPES) continue;
+          types[typeCount] = type;
+          votes[typeCount++] = 0;
+        }
+        votes[i]++;
+      }
+    }
   }
+  if (solid * 2 < total) return AIR;
 
-  // Skip if mesh is already generated and chunk hasn't changed
-  if (chunk->model.meshCount > 0 && !chunk->needsMeshing) { return; }
+  int best = 0;
+  for (int i = 1; i < typeCount; i++)
+  {
+    if (votes[i] > votes[best]) best = i;
+  }
+  return types[best];
+}
 
-  if (chunk->model.meshCount > 0) { REMOVE_CHUNK_MODEL(chunk); }
+// Majority vote of every cell of 1 << lod voxels, border included. The
+// reduced cells sit in the same padded layout, just fewer of them
+static void ReduceChunkMeshSnapshot(const ChunkMeshSnapshot* snapshot,
+                                    ChunkMeshSnapshot* reduced)
+{
+  const int size = CHUNK_SIZE >> snapshot->lod;
+  const int scale = 1 << snapshot->lod;
+  reduced->position = snapshot->position;
+  reduced->uniform = snapshot->uniform;
+  reduced->solidNeighbors = snapshot->solidNeighbors;
+  reduced->lod = snapshot->lod;
+  reduced->baseVertices = NULL;
+  reduced->edited = snapshot->edited;
+  memset(reduced->voxels, AIR, sizeof(reduced->voxels));
 
-  // Count vertices first to avoid over-allocation
-  int vertexCount = 0;
-  for (int x = 0; x < CHUNK_SIZE; x++)
+  for (int z = -1; z <= size; z++)
   {
-    for (int y = 0; y < CHUNK_SIZE; y++)
+    for (int y = -1; y <= size; y++)
     {
-      for (int z = 0; z < CHUNK_SIZE; z++)
+      for (int x = -1; x <= size; x++)
+      {
+        // Edges and corners of the border are never read
+        const int outside = (x < 0 || x == size) + (y < 0 || y == size) +
+                            (z < 0 || z == size);
+        if (outside > 1) continue;
+
+        int first[3], last[3];
+        CellVoxelRange(x, size, scale, &first[0], &last[0]);
+        CellVoxelRange(y, size, scale, &first[1], &last[1]);
+        CellVoxelRange(z, size, scale, &first[2], &last[2]);
+        reduced->voxels[PADDED_INDEX(x, y, z)] =
+          MajorityType(snapshot->voxels, first, last);
+      }
+    }
+  }
+}
+
+// Makes room for at least extra more quads. Vertices are written straight
+// into this thread's mesh arena, which only moves them if its block fills up
+static bool ReserveQuads(ChunkMeshData* data, int* capacity, const int extra)
+{
+  const int needed = data->quadCount + extra;
+  if (needed <= *capacity) return true;
+
+  int newCapacity = *capacity > 0 ? *capacity : INITIAL_QUAD_CAPACITY;
+  while (newCapacity < needed)
+    newCapacity *= 2;
+
+  uint32_t* vertices = MeshArenaReserve(
+    data->vertices, (size_t)data->quadCount * 4, (size_t)newCapacity * 4);
+  if (!vertices)
+  {
+    TraceLog(LOG_ERROR, "Failed to grow chunk mesh data");
+    data->vertices = NULL;
+    return false;
+  }
+  data->vertices = vertices;
+  *capacity = newCapacity;
+  return true;
+}
+
+// Appends the 4 vertices of a face spanning size cells, starting at position.
+// Cells are scale voxels across
+static void WriteQuad(ChunkMeshData* data, const Face face,
+                      const unsigned char type, const int x, const int y,
+                      const int z, const int sizeX, const int sizeY,
+                      const int sizeZ, const int scale)
+{
+  uint32_t* vertex = &data->vertices[data->quadCount * 4];
+  for (int v = 0; v < 4; v++)
+  {
+    const Vector3I corner = faceCorners[face][v];
+    vertex[v] = PACK_CHUNK_VERTEX((x + corner.x * sizeX) * scale,
+                                  (y + corner.y * sizeY) * scale,
+                                  (z + corner.z * sizeZ) * scale, face, type);
+  }
+  data->quadCount++;
+}
+
+// Outermost layer of the chunk on the side a face points to
+static int BorderLayer(const Face face, const int size)
+{
+  return face == TOP || face == RIGHT || face == FRONT ? size - 1 : 0;
+}
+
+// Range of layers that can have visible faces, just the border for uniform
+// chunks and nothing at all when the neighbor on that side is solid
+static bool GetFaceLayers(const ChunkMeshSnapshot* snapshot, const Face face,
+                          const int size, int* firstLayer, int* lastLayer)
+{
+  if (!snapshot->uniform)
+  {
+    *firstLayer = 0;
+    *lastLayer = size - 1;
+    return true;
+  }
+  if (snapshot->solidNeighbors & 1 << face) return false;
+  *firstLayer = *lastLayer = BorderLayer(face, size);
+  return true;
+}
+
+// Naive mesh of a uniform chunk, a quad per cell face exposed on the border.
+// The meshers work on size cells along each axis, each scale voxels across
+static bool BuildNaiveBorderMesh(const ChunkMeshSnapshot* snapshot,
+                                 const int size, const int scale,
+                                 ChunkMeshData* data)
+{
+  const unsigned char* voxels = snapshot->voxels;
+  int capacity = 0;
+
+  for (Face face = 0; face < 6; face++)
+  {
+    int layer, lastLayer;
+    if (!GetFaceLayers(snapshot, face, size, &layer, &lastLayer)) continue;
+    for (int v = 0; v < size; v++)
+    {
+      for (int u = 0; u < size; u++)
       {
-        const VoxelType type = chunk->voxels[VOXEL_INDEX(x, y, z)].type;
+        int x, y, z;
+        FaceToVoxel(face, u, v, layer, &x, &y, &z);
+        const int index = PADDED_INDEX(x, y, z);
+        if (voxels[index + neighborOffsets[face]] != AIR) continue;
+        if (!ReserveQuads(data, &capacity, 1)) return false;
+        WriteQuad(data, face, voxels[index], x, y, z, 1, 1, 1, scale);
+      }
+    }
+  }
+
+  data->naiveQuadCount = data->quadCount;
+  return true;
+}
+
+// One quad per exposed cell face
+static bool BuildNaiveMesh(const ChunkMeshSnapshot* snapshot, const int size,
+                           const int scale, ChunkMeshData* data)
+{
+  if (snapshot->uniform)
+    return BuildNaiveBorderMesh(snapshot, size, scale, data);
+
+  const unsigned char* voxels = snapshot->voxels;
+  int capacity = 0;
+
+  for (int z = 0; z < size; z++)
+  {
+    for (int y = 0; y < size; y++)
+    {
+      for (int x = 0; x < size; x++)
+      {
+        const int index = PADDED_INDEX(x, y, z);
+        const unsigned char type = voxels[index];
         if (type == AIR) continue;
+        if (!ReserveQuads(data, &capacity, 6)) return false;
+
         for (Face face = 0; face < 6; face++)
         {
-          if (IsFaceExposed(chunk, x, y, z, face)) { vertexCount += 6; }
+          if (voxels[index + neighborOffsets[face]] != AIR) continue;
+          WriteQuad(data, face, type, x, y, z, 1, 1, 1, scale);
         }
       }
     }
   }
 
-  if (vertexCount == 0)
-  {
-    chunk->needsMeshing = false;
-    return;
-  }
+  data->naiveQuadCount = data->quadCount;
+  return true;
+}
 
-  // Allocate exact size needed
-  Vertex* vertices = malloc(vertexCount * sizeof(Vertex));
-  int currentVertex = 0;
+// Copies a layer of the snapshot's base mesh, which no edit has touched
+static bool CopyBaseLayer(const ChunkMeshSnapshot* snapshot, const int slot,
+                          ChunkMeshData* data, int* capacity)
+{
+  const int first = snapshot->baseLayers.starts[slot];
+  const int count = snapshot->baseLayers.starts[slot + 1] - first;
+  if (count == 0) return true;
+  if (!ReserveQuads(data, capacity, count)) return false;
+  memcpy(&data->vertices[data->quadCount * 4],
+         &snapshot->baseVertices[first * 4],
+         (size_t)count * 4 * sizeof(uint32_t));
+  data->quadCount += count;
+  return true;
+}
+
+// Merges coplanar faces of the same type into as few rectangles as possible.
+// Full resolution meshes note where each layer starts in data->layers, and
+// with a base mesh in the snapshot only its dirty layers are meshed again
+static bool BuildGreedyMesh(const ChunkMeshSnapshot* snapshot, const int size,
+                            const int scale, ChunkMeshData* data)
+{
+  const unsigned char* voxels = snapshot->voxels;
+  unsigned char mask[CHUNK_SIZE * CHUNK_SIZE];
+  int capacity = 0;
+  int exposedFaces = 0;
+  data->layered = size == CHUNK_SIZE;
+  const bool hasBase = data->layered && snapshot->baseVertices;
 
-  // Generate mesh data
-  for (int x = 0; x < CHUNK_SIZE; x++)
+  for (Face face = 0; face < 6; face++)
   {
-    for (int y = 0; y < CHUNK_SIZE; y++)
+    const int offset = neighborOffsets[face];
+    int firstLayer, lastLayer;
+    if (!GetFaceLayers(snapshot, face, size, &firstLayer, &lastLayer))
     {
-      for (int z = 0; z < CHUNK_SIZE; z++)
+      firstLayer = 0;
+      lastLayer = -1;
+    }
+    for (int layer = 0; layer < size; layer++)
+    {
+      const int slot = face * CHUNK_SIZE + layer;
+      if (data->layered)
       {
-        const VoxelType type = chunk->voxels[VOXEL_INDEX(x, y, z)].type;
-        if (type == AIR) continue;
+        data->layers.starts[slot] = (unsigned short)data->quadCount;
+        data->layers.exposed[slot] = 0;
+      }
+      if (layer < firstLayer || layer > lastLayer) continue;
 
-        const Color baseColor = voxelColors[type];
+      if (hasBase && !(snapshot->dirtyLayers[face] >> layer & 1))
+      {
+        if (!CopyBaseLayer(snapshot, slot, data, &capacity)) return false;
+        data->layers.exposed[slot] = snapshot->baseLayers.exposed[slot];
+        exposedFaces += data->layers.exposed[slot];
+        data->partial = true;
+        continue;
+      }
 
-        for (Face face = 0; face < 6; face++)
+      // Gather the visible faces of this layer
+      const int exposedBefore = exposedFaces;
+      for (int v = 0; v < size; v++)
+      {
+        for (int u = 0; u < size; u++)
         {
-          if (!IsFaceExposed(chunk, x, y, z, face)) continue;
+          int x, y, z;
+          FaceToVoxel(face, u, v, layer, &x, &y, &z);
+          const int index = PADDED_INDEX(x, y, z);
+          const unsigned char type =
+            voxels[index + offset] == AIR ? voxels[index] : AIR;
+          mask[MASK_INDEX(u, v)] = type;
+          exposedFaces += type != AIR;
+        }
+      }
+      if (data->layered)
+        data->layers.exposed[slot] = (unsigned short)(exposedFaces -
+                                                      exposedBefore);
 
-          const Color shadedColor =
-            ApplyShading(baseColor, faces[face].shadeFactor);
-          const float floatX = (float)x;
-          const float floatY = (float)y;
-          const float floatZ = (float)z;
+      // Grow each face as wide as possible along u, then as tall along v
+      for (int v = 0; v < size; v++)
+      {
+        for (int u = 0; u < size;)
+        {
+          const unsigned char type = mask[MASK_INDEX(u, v)];
+          if (type == AIR)
+          {
+            u++;
+            continue;
+          }
+
+          int width = 1;
+          while (u + width < size &&
+                 mask[MASK_INDEX(u + width, v)] == type)
+            width++;
 
-          for (int v = 0; v < 6; v++)
+          int height = 1;
+          while (v + height < size)
           {
-            vertices[currentVertex].position.x =
-              floatX + faces[face].vertices[v].x;
-            vertices[currentVertex].position.y =
-              floatY + faces[face].vertices[v].y;
-            vertices[currentVertex].position.z =
-              floatZ + faces[face].vertices[v].z;
-            vertices[currentVertex].color = shadedColor;
-            currentVertex++;
+            bool rowMatches = true;
+            for (int i = 0; i < width && rowMatches; i++)
+              rowMatches = mask[MASK_INDEX(u + i, v + height)] == type;
+            if (!rowMatches) break;
+            height++;
           }
+
+          // Consume the merged faces
+          for (int j = 0; j < height; j++)
+            memset(&mask[MASK_INDEX(u, v + j)], AIR, width);
+
+          if (!ReserveQuads(data, &capacity, 1)) return false;
+          int x, y, z, sizeX, sizeY, sizeZ;
+          FaceToVoxel(face, u, v, layer, &x, &y, &z);
+          FaceToVoxel(face, width, height, 1, &sizeX, &sizeY, &sizeZ);
+          WriteQuad(data, face, type, x, y, z, sizeX, sizeY, sizeZ, scale);
+          u += width;
         }
       }
     }
   }
 
-  // Create and upload mesh
-  Mesh mesh = {0};
-  mesh.vertexCount = vertexCount;
-  mesh.triangleCount = vertexCount / 3;
-  mesh.vertices = malloc(vertexCount * 3 * sizeof(float));
-  mesh.colors = malloc(vertexCount * 4);
+  if (data->layered)
+    data->layers.starts[6 * CHUNK_SIZE] = (unsigned short)data->quadCount;
+  data->naiveQuadCount = exposedFaces;
+  return true;
+}
+
+void BuildChunkMesh(const ChunkMeshSnapshot* snapshot, const MeshingMode mode,
+                    ChunkMeshData* data)
+{
+  data->position = snapshot->position;
+  data->quadCount = 0;
+  data->naiveQuadCount = 0;
+  data->vertices = NULL;
+  data->layered = false;
+  data->edited = snapshot->edited;
+  data->partial = false;
+  // Taken at full resolution, a reduced mesh hides nothing it wouldn't
+  data->faceConnections = ChunkFaceConnections(snapshot);
 
-  for (int i = 0; i < vertexCount; i++)
+  // Far chunks are meshed from a reduced copy, in cells of 1 << lod voxels
+  ChunkMeshSnapshot reduced;
+  if (snapshot->lod > 0)
   {
-    const int vIdx = i * 3;
-    const int cIdx = i * 4;
-    mesh.vertices[vIdx] = vertices[i].position.x;
-    mesh.vertices[vIdx + 1] = vertices[i].position.y;
-    mesh.vertices[vIdx + 2] = vertices[i].position.z;
-    mesh.colors[cIdx] = vertices[i].color.r;
-    mesh.colors[cIdx + 1] = vertices[i].color.g;
-    mesh.colors[cIdx + 2] = vertices[i].color.b;
-    mesh.colors[cIdx + 3] = vertices[i].color.a;
+    ReduceChunkMeshSnapshot(snapshot, &reduced);
+    snapshot = &reduced;
+  }
+  const int size = CHUNK_SIZE >> snapshot->lod;
+  const int scale = 1 << snapshot->lod;
+
+  const bool built =
+    mode == MESHING_GREEDY ? BuildGreedyMesh(snapshot, size, scale, data)
+                           : BuildNaiveMesh(snapshot, size, scale, data);
+  if (built && data->quadCount > MAX_CHUNK_QUADS)
+  {
+    TraceLog(LOG_ERROR, "Chunk mesh has too many quads (%d)", data->quadCount);
+  }
+  else if (built && data->quadCount > 0)
+  {
+    MeshArenaCommit(data->vertices, (size_t)data->quadCount * 4);
+    return;
   }
 
-  UploadMesh(&mesh, false);
-  chunk->model = LoadModelFromMesh(mesh);
+  // Meshes that aren't kept were never committed, the arena just reuses them
+  data->vertices = NULL;
+  data->quadCount = 0;
+  data->layered = false;
+  data->partial = false;
+}
+
+void FreeChunkMeshData(ChunkMeshData* data)
+{
+  MeshArenaFree(data->vertices);
+  data->vertices = NULL;
+  data->quadCount = 0;
+}
+
+static ChunkMeshJob* AcquireMeshJob(void)
+{
+  ChunkMeshJob* job;
+  if (spareJobs && DArrayPop(spareJobs, &job)) return job;
+  return malloc(sizeof(ChunkMeshJob));
+}
+
+static void ReleaseMeshJob(ChunkMeshJob* job)
+{
+  free(job->snapshot.baseVertices);
+  job->snapshot.baseVertices = NULL;
+  if (!spareJobs) spareJobs = DArrayCreate(sizeof(ChunkMeshJob*));
+  if (spareJobs && DArraySize(spareJobs) < SPARE_MESH_JOBS &&
+      DArrayPush(spareJobs, &job))
+    return;
+  free(job);
+}
+
+// Worker side of meshing
+static void BuildChunkMeshJob(void* jobData)
+{
+  ChunkMeshJob* job = jobData;
+  BuildChunkMesh(&job->snapshot, job->mode, &job->data);
+}
+
+// Main thread side of meshing, queues the result for upload
+static void CompleteChunkMeshJob(void* jobData)
+{
+  ChunkMeshJob* job = jobData;
+  if (!readyMeshes) readyMeshes = DArrayCreate(sizeof(ChunkMeshData));
+  if (!readyMeshes || !DArrayPush(readyMeshes, &job->data))
+  {
+    TraceLog(LOG_ERROR, "Failed to queue chunk mesh for upload");
+    // Let the chunk be scheduled again instead of waiting forever
+    Chunk* chunk = GetChunkFromMap(job->data.position.x, job->data.position.y,
+                                   job->data.position.z);
+    if (chunk && chunk->meshTicket == job->data.ticket)
+    {
+      chunk->meshTicket = 0;
+      MarkChunkMeshDirty(chunk);
+    }
+    FreeChunkMeshData(&job->data);
+    ReleaseMeshJob(job);
+    return;
+  }
+
+  ReleaseMeshJob(job);
+}
+
+static EditedMesh* FindEditedMesh(const Vector3I position)
+{
+  if (editedMeshCount == 0) return NULL;
+  for (int i = 0; i < EDITED_MESH_SLOTS; i++)
+  {
+    EditedMesh* mesh = &editedMeshes[i];
+    if (mesh->vertices && mesh->position.x == position.x &&
+        mesh->position.y == position.y && mesh->position.z == position.z)
+      return mesh;
+  }
+  return NULL;
+}
+
+static void DropEditedMesh(EditedMesh* mesh)
+{
+  free(mesh->vertices);
+  mesh->vertices = NULL;
+  editedMeshCount--;
+}
+
+// Keeps a copy of a freshly built mesh for the chunk's next edit, in its old
+// slot or the one used the longest ago. Must run before the vertices are
+// moved to region coordinates
+static void KeepEditedMesh(const ChunkMeshData* data)
+{
+  EditedMesh* slot = FindEditedMesh(data->position);
+  if (!slot)
+  {
+    slot = &editedMeshes[0];
+    for (int i = 0; i < EDITED_MESH_SLOTS && slot->vertices; i++)
+    {
+      if (!editedMeshes[i].vertices ||
+          editedMeshes[i].lastUse < slot->lastUse)
+        slot = &editedMeshes[i];
+    }
+    if (slot->vertices) DropEditedMesh(slot);
+  }
+
+  const size_t bytes = (size_t)data->quadCount * 4 * sizeof(uint32_t);
+  uint32_t* vertices = slot->vertices ? realloc(slot->vertices, bytes)
+                                      : malloc(bytes);
+  if (!vertices)
+  {
+    // Without a copy the next edit just meshes the whole chunk
+    if (slot->vertices) DropEditedMesh(slot);
+    return;
+  }
+  if (!slot->vertices) editedMeshCount++;
+  memcpy(vertices, data->vertices, bytes);
+  slot->position = data->position;
+  slot->vertices = vertices;
+  slot->layers = data->layers;
+  slot->lastUse = ++editedMeshClock;
+}
+
+// Hands the job a copy of the chunk's last mesh when it is kept, so only the
+// layers flagged by edits since get meshed again
+static void AttachEditedMesh(const Chunk* chunk, ChunkMeshSnapshot* snapshot)
+{
+  // Which of the axis' layers the faces of each Face depend on
+  static const int faceAxes[6] = {1, 1, 0, 0, 2, 2};
+
+  if (snapshot->lod > 0 || snapshot->uniform) return;
+  EditedMesh* mesh = FindEditedMesh(chunk->position);
+  if (!mesh) return;
+
+  const int quadCount = mesh->layers.starts[6 * CHUNK_SIZE];
+  const size_t bytes = (size_t)quadCount * 4 * sizeof(uint32_t);
+  snapshot->baseVertices = malloc(bytes > 0 ? bytes : 1);
+  if (!snapshot->baseVertices) return;
+  memcpy(snapshot->baseVertices, mesh->vertices, bytes);
+  snapshot->baseLayers = mesh->layers;
+  mesh->lastUse = ++editedMeshClock;
+
+  // Bit l + 1 of an axis is layer l, so a face looking up or out depends on
+  // its own layer and the next one, and a face looking down or in on its own
+  // layer and the one before
+  for (Face face = 0; face < 6; face++)
+  {
+    const unsigned int layers = chunk->dirtyLayers[faceAxes[face]];
+    const bool positive = face == TOP || face == RIGHT || face == FRONT;
+    const unsigned int dirty =
+      positive ? layers >> 1 | layers >> 2 : layers | layers >> 1;
+    snapshot->dirtyLayers[face] = (unsigned short)(dirty & 0xFFFF);
+  }
+}
+
+// Solid chunks whose six neighbors are solid too have no visible faces
+static bool IsChunkBuried(const Chunk* chunk)
+{
+  if (!ChunkVoxelsIsSolid(&chunk->voxels)) return false;
+
+  for (Face face = 0; face < 6; face++)
+  {
+    const Chunk* neighbor =
+      GetChunkFromMap(chunk->position.x + (face == RIGHT) - (face == LEFT),
+                      chunk->position.y + (face == TOP) - (face == BOTTOM),
+                      chunk->position.z + (face == FRONT) - (face == BACK));
+    if (!neighbor || !ChunkVoxelsIsSolid(&neighbor->voxels)) return false;
+  }
+  return true;
+}
+
+void ScheduleChunkMesh(Chunk* chunk, const MeshingMode mode)
+{
+  if (!chunk)
+  {
+    TraceLog(LOG_ERROR, "Null chunk passed to mesh generation");
+    return;
+  }
+
+  chunk->lodLevel =
+    (unsigned char)ChunkLodLevel(chunk->position, lodCenter, lodDistance);
+
+  // Nothing to see in empty chunks, or solid ones walled in by solid chunks.
+  // Any mesh still in flight for it is stale now
+  if (ChunkVoxelsIsEmpty(&chunk->voxels) || IsChunkBuried(chunk))
+  {
+    chunk->faceConnections = ChunkVoxelsIsEmpty(&chunk->voxels)
+                               ? ALL_FACES_CONNECTED
+                               : 0;
+    UnloadChunkMesh(chunk);
+    chunk->meshTicket = 0;
+    chunk->needsMeshing = false;
+    memset(chunk->dirtyLayers, 0, sizeof(chunk->dirtyLayers));
+    return;
+  }
+
+  // Only edits flag some of the layers, anything else flags them all
+  bool edited = false;
+  for (int axis = 0; axis < 3; axis++)
+  {
+    if (chunk->dirtyLayers[axis] != ALL_LAYERS_DIRTY &&
+        chunk->dirtyLayers[axis] != 0)
+      edited = true;
+  }
+
+  ChunkMeshJob* job = AcquireMeshJob();
+  if (!job)
+  {
+    TraceLog(LOG_ERROR, "Failed to allocate chunk mesh job");
+    return;
+  }
+
+  TakeChunkMeshSnapshot(chunk, &job->snapshot);
+  job->snapshot.edited = edited;
+  if (edited && mode == MESHING_GREEDY) AttachEditedMesh(chunk, &job->snapshot);
+  job->mode = mode;
+  job->data.ticket = nextMeshTicket++;
+  if (nextMeshTicket == 0) nextMeshTicket = 1; // 0 means no mesh job queued
+
+  if (!JobSystemSubmit(BuildChunkMeshJob, CompleteChunkMeshJob, job))
+  {
+    TraceLog(LOG_ERROR, "Failed to queue chunk mesh job");
+    ReleaseMeshJob(job);
+    return;
+  }
+
+  // Edits made from here on will flag the chunk again
+  chunk->meshTicket = job->data.ticket;
   chunk->needsMeshing = false;
+  memset(chunk->dirtyLayers, 0, sizeof(chunk->dirtyLayers));
+}
 
-  free(vertices);
+static void QueueDirtyChunk(Chunk* chunk)
+{
+  if (chunk->needsMeshing) return;
+
+  if (!dirtyChunks) dirtyChunks = DArrayCreate(sizeof(ChunkKey));
+  const ChunkKey key = {chunk->position.x, chunk->position.y,
+                        chunk->position.z};
+  if (!dirtyChunks || !DArrayPush(dirtyChunks, &key))
+  {
+    TraceLog(LOG_ERROR, "Failed to queue chunk (%d, %d, %d) for meshing",
+             key.chunkX, key.chunkY, key.chunkZ);
+    return;
+  }
+  chunk->needsMeshing = true;
 }
+
+void MarkChunkMeshDirty(Chunk* chunk)
+{
+  for (int axis = 0; axis < 3; axis++)
+    chunk->dirtyLayers[axis] = ALL_LAYERS_DIRTY;
+  QueueDirtyChunk(chunk);
+}
+
+void MarkChunkVoxelDirty(Chunk* chunk, const int x, const int y, const int z)
+{
+  // A voxel of the border is only seen by the faces looking across it
+  const int coords[3] = {x, y, z};
+  int borderAxis = -1;
+  for (int axis = 0; axis < 3; axis++)
+  {
+    if (coords[axis] < 0 || coords[axis] >= CHUNK_SIZE) borderAxis = axis;
+  }
+  unsigned int layers[3] = {0};
+  for (int axis = 0; axis < 3; axis++)
+  {
+    if (borderAxis < 0 || borderAxis == axis)
+      layers[axis] = 1u << (coords[axis] + 1);
+  }
+  MarkChunkLayersDirty(chunk, layers);
+}
+
+void MarkChunkLayersDirty(Chunk* chunk, const unsigned int layers[3])
+{
+  for (int axis = 0; axis < 3; axis++)
+    chunk->dirtyLayers[axis] |= layers[axis] & ALL_LAYERS_DIRTY;
+  QueueDirtyChunk(chunk);
+}
+
+void ScheduleDirtyChunkMeshes(const MeshingMode mode)
+{
+  if (!dirtyChunks) return;
+
+  ChunkKey* keys = dirtyChunks->data;
+  size_t kept = 0;
+  for (size_t i = 0; i < DArraySize(dirtyChunks); i++)
+  {
+    Chunk* chunk = GetChunkFromMap(keys[i].chunkX, keys[i].chunkY,
+                                   keys[i].chunkZ);
+    // Unloaded since, or already taken care of by an earlier entry
+    if (!chunk || !chunk->needsMeshing) continue;
+
+    if (!chunk->meshTicket) ScheduleChunkMesh(chunk, mode);
+    // Still waiting on the mesh in flight, or it couldn't be queued
+    if (chunk->needsMeshing) keys[kept++] = keys[i];
+  }
+  dirtyChunks->size = kept;
+}
+
+void ClearDirtyChunkMeshes()
+{
+  if (dirtyChunks) dirtyChunks->size = 0;
+}
+
+static void CountChunkMesh(const Chunk* chunk, const int sign)
+{
+  if (!chunk->mesh.page) return;
+
+  meshStats.meshCount += sign;
+  meshStats.quadCount += sign * chunk->mesh.quadCount;
+  meshStats.naiveQuadCount += sign * chunk->naiveQuadCount;
+  meshStats.bufferQuadCount += sign * chunk->mesh.quadCapacity;
+}
+
+// Replaces the chunk's GPU mesh with the freshly built one, in the same range
+// of its draw region when it still fits
+static void UploadChunkMesh(Chunk* chunk, ChunkMeshData* data)
+{
+  chunk->meshTicket = 0;
+  chunk->faceConnections = data->faceConnections;
+  if (data->quadCount == 0)
+  {
+    UnloadChunkMesh(chunk);
+    return;
+  }
+
+  // Edited chunks keep a copy for their next edit, any mesh built since
+  // replaces it
+  EditedMesh* edited = FindEditedMesh(chunk->position);
+  if (data->layered && (data->edited || edited))
+    KeepEditedMesh(data);
+  else if (edited)
+    DropEditedMesh(edited);
+
+  const bool inPlace = chunk->mesh.page &&
+                       CanReuseChunkBuffer(chunk->mesh.quadCapacity,
+                                           data->quadCount);
+  CountChunkMesh(chunk, -1);
+  chunk->naiveQuadCount = 0;
+  if (!UploadChunkToRegion(&chunk->mesh, chunk->position, data->vertices,
+                           data->quadCount))
+  {
+    TraceLog(LOG_ERROR, "Failed to upload mesh of chunk (%d, %d, %d)",
+             chunk->position.x, chunk->position.y, chunk->position.z);
+    return;
+  }
+  chunk->naiveQuadCount = data->naiveQuadCount;
+  CountChunkMesh(chunk, 1);
+
+  meshStats.uploads++;
+  if (inPlace) meshStats.inPlaceUploads++;
+  if (data->partial) meshStats.partialUploads++;
+}
+
+int UploadReadyChunkMeshes(const int budget)
+{
+  if (!readyMeshes || DArraySize(readyMeshes) == 0) return 0;
+
+  ChunkMeshData* meshes = readyMeshes->data;
+  const int readyCount = (int)DArraySize(readyMeshes);
+  int processed = 0;
+  int uploaded = 0;
+
+  // Oldest meshes first, stale results don't count towards the budget
+  while (processed < readyCount && uploaded < budget)
+  {
+    ChunkMeshData* data = &meshes[processed++];
+    Chunk* chunk =
+      GetChunkFromMap(data->position.x, data->position.y, data->position.z);
+
+    // Only the latest job queued for a chunk is allowed to replace its mesh
+    if (chunk && chunk->meshTicket == data->ticket)
+    {
+      UploadChunkMesh(chunk, data);
+      uploaded++;
+    }
+
+    FreeChunkMeshData(data);
+  }
+
+  memmove(meshes, meshes + processed,
+          (readyCount - processed) * sizeof(ChunkMeshData));
+  readyMeshes->size -= processed;
+  return uploaded;
+}
+
+void ClearReadyChunkMeshes()
+{
+  if (readyMeshes)
+  {
+    ChunkMeshData* meshes = readyMeshes->data;
+    for (size_t i = 0; i < DArraySize(readyMeshes); i++)
+      FreeChunkMeshData(&meshes[i]);
+    readyMeshes->size = 0;
+  }
+
+  // Spare jobs aren't referenced by any queued work, let them go too
+  ChunkMeshJob* job;
+  while (spareJobs && DArrayPop(spareJobs, &job))
+    free(job);
+
+  // So are the copies kept for edits, chunks just mesh whole without them
+  for (int i = 0; i < EDITED_MESH_SLOTS; i++)
+  {
+    if (editedMeshes[i].vertices) DropEditedMesh(&editedMeshes[i]);
+  }
+}
+
+int GetReadyChunkMeshCount()
+{
+  return readyMeshes ? (int)DArraySize(readyMeshes) : 0;
+}
+
+void UnloadChunkMesh(Chunk* chunk)
+{
+  EditedMesh* edited = FindEditedMesh(chunk->position);
+  if (edited) DropEditedMesh(edited);
+  if (!chunk->mesh.page) return;
+
+  CountChunkMesh(chunk, -1);
+  RemoveChunkFromRegion(&chunk->mesh);
+  chunk->naiveQuadCount = 0;
+}
+
+ChunkMeshStats GetChunkMeshStats() { return meshStats; }
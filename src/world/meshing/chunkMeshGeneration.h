@@ -26,8 +26,133 @@
 #ifndef CHUNK_MESH_GENERATION_H
 #define CHUNK_MESH_GENERATION_H
 
+#include <stdint.h>
 #include "dataTypes.h"
 
-void GenerateChunkMesh(Chunk* chunk);
+// Packed chunk vertex, 7 bits per axis, 3 bits of face and 8 bits of voxel
+// type. Must match the decoding in the chunk shader
+#define PACK_CHUNK_VERTEX(x, y, z, face, type)                                 \
+  ((uint32_t)(x) | (uint32_t)(y) << 7 | (uint32_t)(z) << 14 |                  \
+   (uint32_t)(face) << 21 | (uint32_t)(type) << 24)
+
+// Highest level of detail, each level halves the resolution of a chunk mesh
+#define MAX_CHUNK_LOD 3
+
+#define PADDED_CHUNK_SIZE (CHUNK_SIZE + 2)
+#define PADDED_INDEX(x, y, z)                                                  \
+  ((x) + 1 + PADDED_CHUNK_SIZE * ((y) + 1 + PADDED_CHUNK_SIZE * ((z) + 1)))
+
+// Dirty layer bits of a chunk, one per padded coordinate from -1 to
+// CHUNK_SIZE, see MarkChunkVoxelDirty
+#define ALL_LAYERS_DIRTY ((1u << PADDED_CHUNK_SIZE) - 1)
+
+// Where each layer of a greedy mesh starts, quads are written face by face and
+// layer by layer, so the layers no edit touched can be kept by the next mesh.
+// Layer l of face f is at f * CHUNK_SIZE + l
+typedef struct ChunkMeshLayers
+{
+  unsigned short starts[6 * CHUNK_SIZE + 1]; // Last entry is the quad count
+  unsigned short exposed[6 * CHUNK_SIZE];    // Faces before merging
+} ChunkMeshLayers;
+
+// Copy of everything needed to mesh a chunk, so meshing can happen off the
+// main thread while the world keeps changing
+typedef struct ChunkMeshSnapshot
+{
+  Vector3I position;
+  // Voxel types of the chunk plus a one voxel border taken from its six
+  // neighbors, local coordinates run from -1 to CHUNK_SIZE (see PADDED_INDEX).
+  // Missing neighbors are AIR, the edges and corners are never read
+  unsigned char
+    voxels[PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE];
+  // Uniform chunks only have faces on their border, and none on the sides
+  // whose neighbor is solid (bit per Face)
+  bool uniform;
+  unsigned char solidNeighbors;
+  // Level of detail to mesh at, snapshots are always taken at full resolution
+  // and reduced to cells of 1 << lod voxels by BuildChunkMesh. The border is
+  // left as AIR on sides whose neighbor is at another level, so faces there
+  // cover the seam between the two
+  unsigned char lod;
+  // Previous greedy mesh of the chunk (owned by whoever set it), or NULL to
+  // mesh everything. When set, only the layers flagged per Face in
+  // dirtyLayers are meshed again and the rest are copied from it
+  uint32_t* baseVertices;
+  ChunkMeshLayers baseLayers;
+  unsigned short dirtyLayers[6];
+  bool edited; // Taken for an edit, passed on to ChunkMeshData
+} ChunkMeshSnapshot;
+
+// CPU side mesh data, waiting to be uploaded to the GPU
+typedef struct ChunkMeshData
+{
+  Vector3I position;
+  unsigned int ticket;
+  int quadCount;
+  int naiveQuadCount; // What the naive mesher would have produced
+  uint32_t* vertices; // 4 packed vertices per quad
+  uint16_t faceConnections; // See ChunkFaceConnections
+  bool layered;             // Full resolution greedy mesh, layers is set
+  bool edited;              // Meshed after an edit, worth keeping on the CPU
+  bool partial;             // Some layers came from the snapshot's base
+  ChunkMeshLayers layers;
+} ChunkMeshData;
+
+typedef struct ChunkMeshStats
+{
+  int meshCount;
+  long long quadCount;
+  long long naiveQuadCount;
+  long long bufferQuadCount; // Quads the GPU vertex buffers have room for
+  long long uploads;         // Every mesh uploaded so far
+  long long inPlaceUploads;  // Uploads that reused the chunk's buffer
+  long long partialUploads;  // Uploads that only remeshed edited layers
+} ChunkMeshStats;
+
+/* Level of detail of a chunk, 0 within distance chunks of center, then one
+ * more each time the distance doubles, up to MAX_CHUNK_LOD. A distance of 0
+ * keeps every chunk at full resolution */
+int ChunkLodLevel(Vector3I position, Vector3I center, int distance);
+
+/* Main thread only, sets what meshes scheduled from now on measure their
+ * level of detail from. Returns whether any chunk's level may have changed */
+bool SetChunkMeshLod(Vector3I center, int distance);
+
+// Main thread only, copies the chunk and its neighbor borders
+void TakeChunkMeshSnapshot(const Chunk* chunk, ChunkMeshSnapshot* snapshot);
+
+// Safe to call from any thread
+void BuildChunkMesh(const ChunkMeshSnapshot* snapshot, MeshingMode mode,
+                    ChunkMeshData* data);
+void FreeChunkMeshData(ChunkMeshData* data);
+
+// Queues the chunk to be meshed on the worker threads
+void ScheduleChunkMesh(Chunk* chunk, MeshingMode mode);
+
+// Flags a loaded chunk to be meshed again by the next
+// ScheduleDirtyChunkMeshes, only the flagged chunks are looked at there
+void MarkChunkMeshDirty(Chunk* chunk);
+// Same, for a single voxel edit at local coordinates from -1 to CHUNK_SIZE,
+// so an edit on a neighbor's border can be passed on to this chunk. Only the
+// layers with faces touching the voxel are meshed again, as long as the
+// chunk's last mesh is still around, see ChunkMeshLayers
+void MarkChunkVoxelDirty(Chunk* chunk, int x, int y, int z);
+// Same, for edits of many voxels at once, layers holding the edited
+// coordinates along x, y and z as dirty layer bits
+void MarkChunkLayersDirty(Chunk* chunk, const unsigned int layers[3]);
+// Queues mesh jobs for the flagged chunks that have none in flight
+void ScheduleDirtyChunkMeshes(MeshingMode mode);
+// Forgets every flagged chunk, e.g. when the world is unloaded
+void ClearDirtyChunkMeshes();
+
+// Uploads at most budget finished meshes, returns how many were uploaded
+int UploadReadyChunkMeshes(int budget);
+int GetReadyChunkMeshCount();
+// Drops finished meshes that haven't been uploaded yet
+void ClearReadyChunkMeshes();
+
+// Frees the chunk's GPU mesh, if it has one
+void UnloadChunkMesh(Chunk* chunk);
+ChunkMeshStats GetChunkMeshStats();
 
 #endif // CHUNK_MESH_GENERATION_H
@@ -0,0 +1,244 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Note: tinycthread pulls in windows.h on Windows, which clashes with raylib,
+// so this file must not include raylib.h (or anything that includes it).
+
+#include "meshArena.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tinycthread.h"
+
+#define ARENA_BLOCK_BYTES (512 * 1024) // Fits a couple of the largest meshes
+#define ARENA_RETAINED_BLOCKS 8
+#define ARENA_ALIGNMENT 16
+
+typedef struct ArenaBlock ArenaBlock;
+
+// Sits in front of every mesh so it can find its block when freed
+typedef union MeshHeader
+{
+  ArenaBlock* block;
+  unsigned char padding[ARENA_ALIGNMENT];
+} MeshHeader;
+
+// Data follows the block itself. Blocks in use are in a doubly linked list,
+// free ones in a singly linked one
+struct ArenaBlock
+{
+  ArenaBlock* previous;
+  ArenaBlock* next;
+  size_t size;    // Bytes of data
+  size_t used;    // Bump offset, only moved by the thread building in it
+  int references; // Finished meshes in it, plus one while a thread builds in it
+};
+
+// The block a thread is building its meshes in
+typedef struct ThreadArena
+{
+  ArenaBlock* block;
+  unsigned int generation; // Blocks from before a shutdown are gone
+} ThreadArena;
+
+static once_flag arenaOnce = ONCE_FLAG_INIT;
+static mtx_t arenaLock;
+static ArenaBlock* usedBlocks = NULL;
+static ArenaBlock* freeBlocks = NULL;
+static MeshArenaStats stats = {0};
+static unsigned int generation = 1;
+static _Thread_local ThreadArena threadArena = {NULL, 0};
+
+static void InitArena(void) { mtx_init(&arenaLock, mtx_plain); }
+
+static size_t AlignSize(const size_t bytes)
+{
+  return (bytes + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+}
+
+static unsigned char* BlockData(ArenaBlock* block)
+{
+  return (unsigned char*)block + AlignSize(sizeof(ArenaBlock));
+}
+
+// Blocks, all of these expect the lock to be held
+
+static void LinkBlock(ArenaBlock* block)
+{
+  block->previous = NULL;
+  block->next = usedBlocks;
+  if (usedBlocks) usedBlocks->previous = block;
+  usedBlocks = block;
+}
+
+static void UnlinkBlock(ArenaBlock* block)
+{
+  if (block->previous)
+    block->previous->next = block->next;
+  else
+    usedBlocks = block->next;
+  if (block->next) block->next->previous = block->previous;
+}
+
+// A block nothing references anymore goes back to the free list, unless it's
+// oversized or enough blocks are free already
+static void RetireBlock(ArenaBlock* block)
+{
+  UnlinkBlock(block);
+  if (block->size == ARENA_BLOCK_BYTES &&
+      stats.freeBlockCount < ARENA_RETAINED_BLOCKS)
+  {
+    block->next = freeBlocks;
+    freeBlocks = block;
+    stats.freeBlockCount++;
+    return;
+  }
+  stats.blockCount--;
+  stats.bytes -= block->size;
+  free(block);
+}
+
+static void ReleaseBlock(ArenaBlock* block)
+{
+  if (--block->references == 0) RetireBlock(block);
+}
+
+// A block with at least bytes of room, referenced by the thread taking it
+static ArenaBlock* TakeBlock(const size_t bytes)
+{
+  ArenaBlock* block = NULL;
+  if (bytes <= ARENA_BLOCK_BYTES && freeBlocks)
+  {
+    block = freeBlocks;
+    freeBlocks = block->next;
+    stats.freeBlockCount--;
+  }
+  else
+  {
+    const size_t size = bytes > ARENA_BLOCK_BYTES ? bytes : ARENA_BLOCK_BYTES;
+    block = malloc(AlignSize(sizeof(ArenaBlock)) + size);
+    if (!block) return NULL;
+    block->size = size;
+    stats.blockCount++;
+    stats.bytes += size;
+  }
+  block->used = 0;
+  block->references = 1;
+  LinkBlock(block);
+  return block;
+}
+
+// Meshes
+
+uint32_t* MeshArenaReserve(uint32_t* open, const size_t used,
+                           const size_t count)
+{
+  call_once(&arenaOnce, InitArena);
+  if (threadArena.generation != generation)
+    threadArena = (ThreadArena){NULL, generation};
+
+  // An open mesh always sits at the block's bump offset, so as long as the
+  // block has room it grows in place
+  const size_t bytes = AlignSize(sizeof(MeshHeader) + count * sizeof(uint32_t));
+  ArenaBlock* block = threadArena.block;
+  if (block && block->used + bytes <= block->size)
+  {
+    return (uint32_t*)(BlockData(block) + block->used + sizeof(MeshHeader));
+  }
+
+  // Otherwise it moves to a new block, bringing along what's written so far
+  mtx_lock(&arenaLock);
+  ArenaBlock* next = TakeBlock(bytes);
+  mtx_unlock(&arenaLock);
+  if (!next) return NULL;
+
+  uint32_t* words = (uint32_t*)(BlockData(next) + sizeof(MeshHeader));
+  if (open && used > 0) memcpy(words, open, used * sizeof(uint32_t));
+
+  if (block)
+  {
+    mtx_lock(&arenaLock);
+    ReleaseBlock(block);
+    mtx_unlock(&arenaLock);
+  }
+  threadArena.block = next;
+  return words;
+}
+
+void MeshArenaCommit(uint32_t* open, const size_t used)
+{
+  if (!open || used == 0) return;
+
+  ArenaBlock* block = threadArena.block;
+  MeshHeader* header = (MeshHeader*)open - 1;
+  header->block = block;
+  block->used += AlignSize(sizeof(MeshHeader) + used * sizeof(uint32_t));
+
+  mtx_lock(&arenaLock);
+  block->references++;
+  stats.allocationCount++;
+  mtx_unlock(&arenaLock);
+}
+
+void MeshArenaFree(uint32_t* words)
+{
+  if (!words) return;
+
+  ArenaBlock* block = ((MeshHeader*)words - 1)->block;
+  mtx_lock(&arenaLock);
+  stats.allocationCount--;
+  ReleaseBlock(block);
+  mtx_unlock(&arenaLock);
+}
+
+MeshArenaStats MeshArenaGetStats(void)
+{
+  call_once(&arenaOnce, InitArena);
+  mtx_lock(&arenaLock);
+  const MeshArenaStats result = stats;
+  mtx_unlock(&arenaLock);
+  return result;
+}
+
+void MeshArenaShutdown(void)
+{
+  call_once(&arenaOnce, InitArena);
+  mtx_lock(&arenaLock);
+  while (usedBlocks)
+  {
+    ArenaBlock* next = usedBlocks->next;
+    free(usedBlocks);
+    usedBlocks = next;
+  }
+  while (freeBlocks)
+  {
+    ArenaBlock* next = freeBlocks->next;
+    free(freeBlocks);
+    freeBlocks = next;
+  }
+  stats = (MeshArenaStats){0};
+  generation++;
+  mtx_unlock(&arenaLock);
+}
@@ -0,0 +1,65 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Vertex memory for chunk meshes. Every thread bump allocates its meshes out
+// of a large block of its own, so building a mesh doesn't go through malloc
+// and realloc, and a finished mesh stays where it was written until it has
+// been uploaded. Blocks count the meshes still in them and go back to a free
+// list once they're all released, so the same few blocks get reused instead
+// of fragmenting the heap over a long session.
+// A mesh is built by one thread, but can be freed from any thread.
+
+#ifndef MESH_ARENA_H
+#define MESH_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct MeshArenaStats
+{
+  int blockCount;      // Blocks allocated, free ones included
+  int freeBlockCount;  // Blocks kept around for reuse
+  int allocationCount; // Finished meshes not freed yet
+  size_t bytes;        // Memory of every block
+} MeshArenaStats;
+
+/* Make room for at least count words in the mesh this thread is building,
+ * starting one if open is NULL. A mesh that outgrows the room left in the
+ * block moves to a new one, keeping its first used words. Returns NULL if
+ * memory couldn't be allocated, dropping the mesh */
+uint32_t* MeshArenaReserve(uint32_t* open, size_t used, size_t count);
+
+/* Finish the mesh being built at used words, or drop it if used is 0 */
+void MeshArenaCommit(uint32_t* open, size_t used);
+
+/* Release a finished mesh, NULL is ignored */
+void MeshArenaFree(uint32_t* words);
+
+MeshArenaStats MeshArenaGetStats(void);
+
+/* Free every block, once no thread is building or holding meshes anymore */
+void MeshArenaShutdown(void);
+
+#endif // MESH_ARENA_H
@@ -0,0 +1,480 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Note: this file is kept free of raylib so the SIMD and cpuid headers can't
+// clash with it. Every path has to round exactly like the scalar one, so it's
+// built without floating point contraction (see CMakeLists.txt) and floors
+// with the same truncate and fix up sequence everywhere.
+
+#include "noise.h"
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #define NOISE_X86
+  #include <immintrin.h>
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+  #endif
+  #if defined(__GNUC__) || defined(__clang__)
+    #define NOISE_TARGET_AVX2 __attribute__((target("avx2")))
+  #else
+    #define NOISE_TARGET_AVX2
+  #endif
+#endif
+
+#define SIMPLEX_F2 0.36602540378f            // (sqrt(3) - 1) / 2
+#define SIMPLEX_G2 0.21132486540f            // (3 - sqrt(3)) / 6
+#define SIMPLEX_G2_MINUS_ONE -0.57735026919f // 2 * G2 - 1
+#define SIMPLEX_SCALE 90.0f                  // Brings the output to [-1, 1]
+
+#define HASH_PRIME_X 0x8da6b343u
+#define HASH_PRIME_Y 0xd8163841u
+#define HASH_MIX 0x2c1b3c6du
+#define OCTAVE_SEED_STEP 0x9e3779b9u // Decorrelates the octaves
+
+static NoiseBackend backend = NOISE_BACKEND_SCALAR;
+
+static const char* backendNames[NOISE_BACKEND_COUNT] = {"scalar", "sse2",
+                                                        "avx2"};
+
+// Scalar
+
+static inline uint32_t HashCorner(const uint32_t seed, const int i,
+                                  const int j)
+{
+  uint32_t hash = seed ^ (uint32_t)i * HASH_PRIME_X;
+  hash ^= (uint32_t)j * HASH_PRIME_Y;
+  hash ^= hash >> 15;
+  hash *= HASH_MIX;
+  hash ^= hash >> 13;
+  return hash;
+}
+
+static inline int FloorToInt(const float value)
+{
+  const int truncated = (int)value;
+  return value < (float)truncated ? truncated - 1 : truncated;
+}
+
+// One of 8 gradients, (+-1, +-0.5) or (+-0.5, +-1), dotted with (x, y)
+static inline float Gradient(const uint32_t hash, const float x, const float y)
+{
+  const float u = hash & 4 ? y : x;
+  const float v = hash & 4 ? x : y;
+  return (hash & 1 ? -u : u) + (hash & 2 ? -v : v) * 0.5f;
+}
+
+static inline float Corner(const uint32_t hash, const float x, const float y)
+{
+  float t = 0.5f - x * x - y * y;
+  t = t < 0.0f ? 0.0f : t;
+  t = t * t;
+  return t * t * Gradient(hash, x, y);
+}
+
+float NoiseSimplex2D(const unsigned int seed, const float x, const float y)
+{
+  // Skew into the simplex grid to find the cell, then unskew back
+  const float s = (x + y) * SIMPLEX_F2;
+  const int i = FloorToInt(x + s);
+  const int j = FloorToInt(y + s);
+  const float t = (float)(i + j) * SIMPLEX_G2;
+  const float x0 = x - ((float)i - t);
+  const float y0 = y - ((float)j - t);
+
+  // Which of the cell's two triangles the point is in
+  const int i1 = x0 > y0;
+  const int j1 = !i1;
+  const float x1 = x0 - (float)i1 + SIMPLEX_G2;
+  const float y1 = y0 - (float)j1 + SIMPLEX_G2;
+  const float x2 = x0 + SIMPLEX_G2_MINUS_ONE;
+  const float y2 = y0 + SIMPLEX_G2_MINUS_ONE;
+
+  const float n0 = Corner(HashCorner(seed, i, j), x0, y0);
+  const float n1 = Corner(HashCorner(seed, i + i1, j + j1), x1, y1);
+  const float n2 = Corner(HashCorner(seed, i + 1, j + 1), x2, y2);
+  return (n0 + n1 + n2) * SIMPLEX_SCALE;
+}
+
+static void FbmRowScalar(const FbmNoise* noise, const int x, const int z,
+                         float out[NOISE_ROW_WIDTH])
+{
+  for (int k = 0; k < NOISE_ROW_WIDTH; k++)
+    out[k] = 0.0f;
+
+  float frequency = noise->frequency;
+  float amplitude = 1.0f;
+  for (int octave = 0; octave < noise->octaves; octave++)
+  {
+    const uint32_t seed = noise->seed + (uint32_t)octave * OCTAVE_SEED_STEP;
+    const float zf = (float)z * frequency;
+    for (int k = 0; k < NOISE_ROW_WIDTH; k++)
+    {
+      const float xf = (float)(x + k) * frequency;
+      out[k] = out[k] + amplitude * NoiseSimplex2D(seed, xf, zf);
+    }
+    frequency *= noise->lacunarity;
+    amplitude *= noise->persistence;
+  }
+}
+
+#ifdef NOISE_X86
+
+// SSE2, 4 samples at a time
+
+// SSE2 has no 32 bit multiply, so the even and odd lanes are done as 64 bit
+static inline __m128i MulLo32Sse2(const __m128i a, const __m128i b)
+{
+  const __m128i even = _mm_mul_epu32(a, b);
+  const __m128i odd =
+    _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static inline __m128i HashCornerSse2(const __m128i seed, const __m128i i,
+                                     const __m128i j)
+{
+  __m128i hash = _mm_xor_si128(
+    seed,
+    _mm_xor_si128(MulLo32Sse2(i, _mm_set1_epi32((int)HASH_PRIME_X)),
+                  MulLo32Sse2(j, _mm_set1_epi32((int)HASH_PRIME_Y))));
+  hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 15));
+  hash = MulLo32Sse2(hash, _mm_set1_epi32((int)HASH_MIX));
+  return _mm_xor_si128(hash, _mm_srli_epi32(hash, 13));
+}
+
+static inline __m128i FloorToIntSse2(const __m128 value)
+{
+  const __m128i truncated = _mm_cvttps_epi32(value);
+  // The mask is -1 where truncating rounded up
+  const __m128 roundedUp = _mm_cmplt_ps(value, _mm_cvtepi32_ps(truncated));
+  return _mm_add_epi32(truncated, _mm_castps_si128(roundedUp));
+}
+
+static inline __m128 SelectSse2(const __m128 mask, const __m128 a,
+                                const __m128 b)
+{
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128 GradientSse2(const __m128i hash, const __m128 x,
+                                  const __m128 y)
+{
+  const __m128i four = _mm_set1_epi32(4);
+  const __m128 swap =
+    _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(hash, four), four));
+  const __m128 u = SelectSse2(swap, y, x);
+  const __m128 v = SelectSse2(swap, x, y);
+  // Flip the sign bits straight from the hash bits
+  const __m128 signU = _mm_castsi128_ps(
+    _mm_slli_epi32(_mm_and_si128(hash, _mm_set1_epi32(1)), 31));
+  const __m128 signV = _mm_castsi128_ps(
+    _mm_slli_epi32(_mm_and_si128(hash, _mm_set1_epi32(2)), 30));
+  return _mm_add_ps(_mm_xor_ps(u, signU),
+                    _mm_mul_ps(_mm_xor_ps(v, signV), _mm_set1_ps(0.5f)));
+}
+
+static inline __m128 CornerSse2(const __m128i hash, const __m128 x,
+                                const __m128 y)
+{
+  __m128 t = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.5f), _mm_mul_ps(x, x)),
+                        _mm_mul_ps(y, y));
+  t = _mm_max_ps(t, _mm_setzero_ps());
+  t = _mm_mul_ps(t, t);
+  return _mm_mul_ps(_mm_mul_ps(t, t), GradientSse2(hash, x, y));
+}
+
+static inline __m128 Simplex2DSse2(const __m128i seed, const __m128 x,
+                                   const __m128 y)
+{
+  const __m128 s = _mm_mul_ps(_mm_add_ps(x, y), _mm_set1_ps(SIMPLEX_F2));
+  const __m128i i = FloorToIntSse2(_mm_add_ps(x, s));
+  const __m128i j = FloorToIntSse2(_mm_add_ps(y, s));
+  const __m128 t =
+    _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(i, j)), _mm_set1_ps(SIMPLEX_G2));
+  const __m128 x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+  const __m128 y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+
+  const __m128 lower = _mm_cmpgt_ps(x0, y0);
+  const __m128i one = _mm_set1_epi32(1);
+  const __m128i i1 = _mm_and_si128(_mm_castps_si128(lower), one);
+  const __m128i j1 = _mm_sub_epi32(one, i1);
+  const __m128 i1f = _mm_and_ps(lower, _mm_set1_ps(1.0f));
+  const __m128 j1f = _mm_sub_ps(_mm_set1_ps(1.0f), i1f);
+  const __m128 g2 = _mm_set1_ps(SIMPLEX_G2);
+  const __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, i1f), g2);
+  const __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, j1f), g2);
+  const __m128 x2 = _mm_add_ps(x0, _mm_set1_ps(SIMPLEX_G2_MINUS_ONE));
+  const __m128 y2 = _mm_add_ps(y0, _mm_set1_ps(SIMPLEX_G2_MINUS_ONE));
+
+  const __m128 n0 = CornerSse2(HashCornerSse2(seed, i, j), x0, y0);
+  const __m128 n1 = CornerSse2(
+    HashCornerSse2(seed, _mm_add_epi32(i, i1), _mm_add_epi32(j, j1)), x1, y1);
+  const __m128 n2 = CornerSse2(
+    HashCornerSse2(seed, _mm_add_epi32(i, one), _mm_add_epi32(j, one)), x2,
+    y2);
+  return _mm_mul_ps(_mm_add_ps(_mm_add_ps(n0, n1), n2),
+                    _mm_set1_ps(SIMPLEX_SCALE));
+}
+
+static void FbmRowSse2(const FbmNoise* noise, const int x, const int z,
+                       float out[NOISE_ROW_WIDTH])
+{
+  __m128 sums[NOISE_ROW_WIDTH / 4];
+  for (int b = 0; b < NOISE_ROW_WIDTH / 4; b++)
+    sums[b] = _mm_setzero_ps();
+
+  const __m128i lanes = _mm_setr_epi32(0, 1, 2, 3);
+  float frequency = noise->frequency;
+  float amplitude = 1.0f;
+  for (int octave = 0; octave < noise->octaves; octave++)
+  {
+    const uint32_t seed = noise->seed + (uint32_t)octave * OCTAVE_SEED_STEP;
+    const __m128i seeds = _mm_set1_epi32((int)seed);
+    const __m128 frequencies = _mm_set1_ps(frequency);
+    const __m128 amplitudes = _mm_set1_ps(amplitude);
+    const __m128 zf = _mm_set1_ps((float)z * frequency);
+    for (int b = 0; b < NOISE_ROW_WIDTH / 4; b++)
+    {
+      const __m128i xi = _mm_add_epi32(_mm_set1_epi32(x + b * 4), lanes);
+      const __m128 xf = _mm_mul_ps(_mm_cvtepi32_ps(xi), frequencies);
+      sums[b] = _mm_add_ps(
+        sums[b], _mm_mul_ps(amplitudes, Simplex2DSse2(seeds, xf, zf)));
+    }
+    frequency *= noise->lacunarity;
+    amplitude *= noise->persistence;
+  }
+
+  for (int b = 0; b < NOISE_ROW_WIDTH / 4; b++)
+    _mm_storeu_ps(&out[b * 4], sums[b]);
+}
+
+// AVX2, 8 samples at a time
+
+NOISE_TARGET_AVX2 static inline __m256i
+HashCornerAvx2(const __m256i seed, const __m256i i, const __m256i j)
+{
+  __m256i hash = _mm256_xor_si256(
+    seed,
+    _mm256_xor_si256(
+      _mm256_mullo_epi32(i, _mm256_set1_epi32((int)HASH_PRIME_X)),
+      _mm256_mullo_epi32(j, _mm256_set1_epi32((int)HASH_PRIME_Y))));
+  hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 15));
+  hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32((int)HASH_MIX));
+  return _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 13));
+}
+
+NOISE_TARGET_AVX2 static inline __m256i FloorToIntAvx2(const __m256 value)
+{
+  const __m256i truncated = _mm256_cvttps_epi32(value);
+  const __m256 roundedUp =
+    _mm256_cmp_ps(value, _mm256_cvtepi32_ps(truncated), _CMP_LT_OQ);
+  return _mm256_add_epi32(truncated, _mm256_castps_si256(roundedUp));
+}
+
+NOISE_TARGET_AVX2 static inline __m256 GradientAvx2(const __m256i hash,
+                                                    const __m256 x,
+                                                    const __m256 y)
+{
+  const __m256i four = _mm256_set1_epi32(4);
+  const __m256 swap = _mm256_castsi256_ps(
+    _mm256_cmpeq_epi32(_mm256_and_si256(hash, four), four));
+  const __m256 u = _mm256_blendv_ps(x, y, swap);
+  const __m256 v = _mm256_blendv_ps(y, x, swap);
+  const __m256 signU = _mm256_castsi256_ps(
+    _mm256_slli_epi32(_mm256_and_si256(hash, _mm256_set1_epi32(1)), 31));
+  const __m256 signV = _mm256_castsi256_ps(
+    _mm256_slli_epi32(_mm256_and_si256(hash, _mm256_set1_epi32(2)), 30));
+  return _mm256_add_ps(
+    _mm256_xor_ps(u, signU),
+    _mm256_mul_ps(_mm256_xor_ps(v, signV), _mm256_set1_ps(0.5f)));
+}
+
+NOISE_TARGET_AVX2 static inline __m256 CornerAvx2(const __m256i hash,
+                                                  const __m256 x,
+                                                  const __m256 y)
+{
+  __m256 t = _mm256_sub_ps(
+    _mm256_sub_ps(_mm256_set1_ps(0.5f), _mm256_mul_ps(x, x)),
+    _mm256_mul_ps(y, y));
+  t = _mm256_max_ps(t, _mm256_setzero_ps());
+  t = _mm256_mul_ps(t, t);
+  return _mm256_mul_ps(_mm256_mul_ps(t, t), GradientAvx2(hash, x, y));
+}
+
+NOISE_TARGET_AVX2 static inline __m256 Simplex2DAvx2(const __m256i seed,
+                                                     const __m256 x,
+                                                     const __m256 y)
+{
+  const __m256 s =
+    _mm256_mul_ps(_mm256_add_ps(x, y), _mm256_set1_ps(SIMPLEX_F2));
+  const __m256i i = FloorToIntAvx2(_mm256_add_ps(x, s));
+  const __m256i j = FloorToIntAvx2(_mm256_add_ps(y, s));
+  const __m256 t = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(i, j)),
+                                 _mm256_set1_ps(SIMPLEX_G2));
+  const __m256 x0 = _mm256_sub_ps(x, _mm256_sub_ps(_mm256_cvtepi32_ps(i), t));
+  const __m256 y0 = _mm256_sub_ps(y, _mm256_sub_ps(_mm256_cvtepi32_ps(j), t));
+
+  const __m256 lower = _mm256_cmp_ps(x0, y0, _CMP_GT_OQ);
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i i1 = _mm256_and_si256(_mm256_castps_si256(lower), one);
+  const __m256i j1 = _mm256_sub_epi32(one, i1);
+  const __m256 i1f = _mm256_and_ps(lower, _mm256_set1_ps(1.0f));
+  const __m256 j1f = _mm256_sub_ps(_mm256_set1_ps(1.0f), i1f);
+  const __m256 g2 = _mm256_set1_ps(SIMPLEX_G2);
+  const __m256 x1 = _mm256_add_ps(_mm256_sub_ps(x0, i1f), g2);
+  const __m256 y1 = _mm256_add_ps(_mm256_sub_ps(y0, j1f), g2);
+  const __m256 x2 = _mm256_add_ps(x0, _mm256_set1_ps(SIMPLEX_G2_MINUS_ONE));
+  const __m256 y2 = _mm256_add_ps(y0, _mm256_set1_ps(SIMPLEX_G2_MINUS_ONE));
+
+  const __m256 n0 = CornerAvx2(HashCornerAvx2(seed, i, j), x0, y0);
+  const __m256 n1 = CornerAvx2(
+    HashCornerAvx2(seed, _mm256_add_epi32(i, i1), _mm256_add_epi32(j, j1)),
+    x1, y1);
+  const __m256 n2 = CornerAvx2(
+    HashCornerAvx2(seed, _mm256_add_epi32(i, one), _mm256_add_epi32(j, one)),
+    x2, y2);
+  return _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(n0, n1), n2),
+                       _mm256_set1_ps(SIMPLEX_SCALE));
+}
+
+NOISE_TARGET_AVX2 static void FbmRowAvx2(const FbmNoise* noise, const int x,
+                                         const int z,
+                                         float out[NOISE_ROW_WIDTH])
+{
+  __m256 sums[NOISE_ROW_WIDTH / 8];
+  for (int b = 0; b < NOISE_ROW_WIDTH / 8; b++)
+    sums[b] = _mm256_setzero_ps();
+
+  const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  float frequency = noise->frequency;
+  float amplitude = 1.0f;
+  for (int octave = 0; octave < noise->octaves; octave++)
+  {
+    const uint32_t seed = noise->seed + (uint32_t)octave * OCTAVE_SEED_STEP;
+    const __m256i seeds = _mm256_set1_epi32((int)seed);
+    const __m256 frequencies = _mm256_set1_ps(frequency);
+    const __m256 amplitudes = _mm256_set1_ps(amplitude);
+    const __m256 zf = _mm256_set1_ps((float)z * frequency);
+    for (int b = 0; b < NOISE_ROW_WIDTH / 8; b++)
+    {
+      const __m256i xi = _mm256_add_epi32(_mm256_set1_epi32(x + b * 8), lanes);
+      const __m256 xf = _mm256_mul_ps(_mm256_cvtepi32_ps(xi), frequencies);
+      sums[b] = _mm256_add_ps(
+        sums[b], _mm256_mul_ps(amplitudes, Simplex2DAvx2(seeds, xf, zf)));
+    }
+    frequency *= noise->lacunarity;
+    amplitude *= noise->persistence;
+  }
+
+  for (int b = 0; b < NOISE_ROW_WIDTH / 8; b++)
+    _mm256_storeu_ps(&out[b * 8], sums[b]);
+}
+
+static bool CpuSupportsAvx2(void)
+{
+  #if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) return false;
+  // The OS also has to save the YMM registers on context switches
+  __cpuid(info, 1);
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+  if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+  #else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+  #endif
+}
+
+#endif // NOISE_X86
+
+// Dispatch
+
+void NoiseInit(void)
+{
+  backend = NoiseBackendSupported(NOISE_BACKEND_AVX2) ? NOISE_BACKEND_AVX2
+            : NoiseBackendSupported(NOISE_BACKEND_SSE2)
+              ? NOISE_BACKEND_SSE2
+              : NOISE_BACKEND_SCALAR;
+}
+
+bool NoiseBackendSupported(const NoiseBackend requested)
+{
+  switch (requested)
+  {
+    case NOISE_BACKEND_SCALAR: return true;
+#ifdef NOISE_X86
+    case NOISE_BACKEND_SSE2: return true; // Part of x86-64
+    case NOISE_BACKEND_AVX2: return CpuSupportsAvx2();
+#endif
+    default: return false;
+  }
+}
+
+bool NoiseSetBackend(const NoiseBackend requested)
+{
+  if (!NoiseBackendSupported(requested)) return false;
+  backend = requested;
+  return true;
+}
+
+NoiseBackend NoiseGetBackend(void) { return backend; }
+
+const char* NoiseBackendName(const NoiseBackend requested)
+{
+  if (requested < 0 || requested >= NOISE_BACKEND_COUNT) return "unknown";
+  return backendNames[requested];
+}
+
+void NoiseFbm2DRow(const FbmNoise* noise, const int x, const int z,
+                   float out[NOISE_ROW_WIDTH])
+{
+  switch (backend)
+  {
+#ifdef NOISE_X86
+    case NOISE_BACKEND_AVX2: FbmRowAvx2(noise, x, z, out); break;
+    case NOISE_BACKEND_SSE2: FbmRowSse2(noise, x, z, out); break;
+#endif
+    default: FbmRowScalar(noise, x, z, out); break;
+  }
+
+  // Divide by the summed amplitudes so more octaves don't mean taller output
+  float amplitude = 1.0f;
+  float total = 0.0f;
+  for (int octave = 0; octave < noise->octaves; octave++)
+  {
+    total += amplitude;
+    amplitude *= noise->persistence;
+  }
+  if (total <= 0.0f) return;
+  const float inverseTotal = 1.0f / total;
+  for (int k = 0; k < NOISE_ROW_WIDTH; k++)
+    out[k] *= inverseTotal;
+}
@@ -0,0 +1,73 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Seeded 2D simplex noise and fBm. Lattice gradients come from an integer hash
+// of the corner and seed rather than a permutation table, so a whole row of
+// samples can be evaluated in SIMD lanes without any gathers. The scalar,
+// SSE2 and AVX2 paths do the same float operations in the same order and
+// return bit identical results, which keeps terrain the same on every machine.
+
+#ifndef NOISE_H
+#define NOISE_H
+
+#include <stdbool.h>
+
+#define NOISE_ROW_WIDTH 16 // Samples per row, one chunk wide
+
+typedef enum NoiseBackend
+{
+  NOISE_BACKEND_SCALAR,
+  NOISE_BACKEND_SSE2,
+  NOISE_BACKEND_AVX2,
+  NOISE_BACKEND_COUNT
+} NoiseBackend;
+
+typedef struct FbmNoise
+{
+  unsigned int seed;
+  int octaves;
+  float frequency;   // Of the first octave, in cycles per unit
+  float lacunarity;  // Frequency multiplier between octaves
+  float persistence; // Amplitude multiplier between octaves
+} FbmNoise;
+
+/* Pick the fastest backend the CPU supports, until then rows are scalar */
+void NoiseInit(void);
+
+/* Force a backend, returns false if the CPU or the build doesn't support it */
+bool NoiseSetBackend(NoiseBackend backend);
+NoiseBackend NoiseGetBackend(void);
+bool NoiseBackendSupported(NoiseBackend backend);
+const char* NoiseBackendName(NoiseBackend backend);
+
+/* Single octave of simplex noise in roughly [-1, 1] */
+float NoiseSimplex2D(unsigned int seed, float x, float y);
+
+/* fBm of the NOISE_ROW_WIDTH samples from (x, z) to (x + 15, z) on the
+ * integer grid, normalized back into roughly [-1, 1] */
+void NoiseFbm2DRow(const FbmNoise* noise, int x, int z,
+                   float out[NOISE_ROW_WIDTH]);
+
+#endif // NOISE_H
@@ -0,0 +1,270 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "caveCulling.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_VOLUME (CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE)
+
+// Chunk waiting to be walked out of
+typedef struct VisitStep
+{
+  Chunk* chunk;
+  signed char entry;       // Face the walk came in by, -1 for the start
+  unsigned char travelled; // Bit per Face of every direction taken so far
+} VisitStep;
+
+// Chunk coordinates one step along each Face
+static const Vector3I faceSteps[6] = {
+  {0, 1, 0},  // TOP (+Y)
+  {0, -1, 0}, // BOTTOM (-Y)
+  {-1, 0, 0}, // LEFT (-X)
+  {1, 0, 0},  // RIGHT (+X)
+  {0, 0, 1},  // FRONT (+Z)
+  {0, 0, -1}, // BACK (-Z)
+};
+
+// Buffers reused from frame to frame
+static VisitStep* queue = NULL;
+static Chunk** visibleList = NULL;
+static int listCapacity = 0;
+static unsigned int walkStamp = 0;
+
+static CaveCullStats cullStats = {0};
+
+// Faces come in opposite pairs, TOP/BOTTOM and so on
+static Face OppositeFace(const Face face) { return (Face)(face ^ 1); }
+
+// Bit of a pair of different faces, the 15 pairs are numbered in order
+// (0, 1), (0, 2) ... (4, 5)
+static int FacePairBit(Face a, Face b)
+{
+  if (a > b)
+  {
+    const Face swap = a;
+    a = b;
+    b = swap;
+  }
+  return a * (11 - a) / 2 + (b - a - 1);
+}
+
+bool FacesConnected(const uint16_t connections, const Face a, const Face b)
+{
+  return (connections >> FacePairBit(a, b)) & 1;
+}
+
+// Row of air waiting to spread, bits are x along the row at (y, z)
+typedef struct FillRow
+{
+  unsigned short row; // y + CHUNK_SIZE * z
+  uint16_t bits;
+} FillRow;
+
+// Faces of the chunk the air bits of a row touch, bit per Face
+static unsigned char RowBorderFaces(const int y, const int z,
+                                    const uint16_t bits)
+{
+  const int last = CHUNK_SIZE - 1;
+  return (unsigned char)((y == last) << TOP | (y == 0) << BOTTOM |
+                         (bits & 1) << LEFT | (bits >> last & 1) << RIGHT |
+                         (z == last) << FRONT | (z == 0) << BACK);
+}
+
+uint16_t ChunkFaceConnections(const ChunkMeshSnapshot* snapshot)
+{
+  // Air not reached by any fill yet, a row of x bits per (y, z). Fills work
+  // on whole rows, so they take a few hundred steps instead of 4096
+  uint16_t open[CHUNK_SIZE * CHUNK_SIZE];
+  for (int z = 0; z < CHUNK_SIZE; z++)
+  {
+    for (int y = 0; y < CHUNK_SIZE; y++)
+    {
+      const unsigned char* voxels = &snapshot->voxels[PADDED_INDEX(0, y, z)];
+      uint16_t bits = 0;
+      for (int x = 0; x < CHUNK_SIZE; x++)
+        bits |= (uint16_t)(voxels[x] == AIR) << x;
+      open[y + CHUNK_SIZE * z] = bits;
+    }
+  }
+
+  // Bits are taken out of open as they're pushed, so every push claims at
+  // least one voxel and the stack can't overflow
+  FillRow stack[CHUNK_VOLUME];
+  uint16_t connections = 0;
+  for (int start = 0; start < CHUNK_SIZE * CHUNK_SIZE; start++)
+  {
+    while (open[start])
+    {
+      const uint16_t seed = open[start] & -open[start];
+      open[start] &= ~seed;
+      int top = 0;
+      stack[top++] = (FillRow){(unsigned short)start, seed};
+      unsigned char faces = 0;
+
+      while (top > 0)
+      {
+        const FillRow fill = stack[--top];
+        const int y = fill.row % CHUNK_SIZE;
+        const int z = fill.row / CHUNK_SIZE;
+
+        // Spread along the row as far as the air goes
+        uint16_t bits = fill.bits;
+        for (;;)
+        {
+          const uint16_t grown =
+            (uint16_t)(bits << 1 | bits >> 1) & open[fill.row];
+          if (!grown) break;
+          open[fill.row] &= ~grown;
+          bits |= grown;
+        }
+        faces |= RowBorderFaces(y, z, bits);
+
+        // Then into the rows above, below, in front and behind
+        const int rows[4] = {y > 0 ? fill.row - 1 : -1,
+                             y < CHUNK_SIZE - 1 ? fill.row + 1 : -1,
+                             z > 0 ? fill.row - CHUNK_SIZE : -1,
+                             z < CHUNK_SIZE - 1 ? fill.row + CHUNK_SIZE : -1};
+        for (int i = 0; i < 4; i++)
+        {
+          if (rows[i] < 0) continue;
+          const uint16_t reached = bits & open[rows[i]];
+          if (!reached) continue;
+          open[rows[i]] &= ~reached;
+          stack[top++] = (FillRow){(unsigned short)rows[i], reached};
+        }
+      }
+
+      // The pocket joins every pair of faces it touches
+      for (Face a = 0; a < 6; a++)
+      {
+        if (!(faces & 1 << a)) continue;
+        for (Face b = a + 1; b < 6; b++)
+        {
+          if (faces & 1 << b) connections |= 1 << FacePairBit(a, b);
+        }
+      }
+      if (connections == ALL_FACES_CONNECTED) return connections;
+    }
+  }
+  return connections;
+}
+
+static bool ReserveLists(const int count)
+{
+  if (count <= listCapacity) return true;
+
+  int newCapacity = listCapacity > 0 ? listCapacity : 256;
+  while (newCapacity < count)
+    newCapacity *= 2;
+
+  VisitStep* newQueue = realloc(queue, newCapacity * sizeof(VisitStep));
+  if (!newQueue) return false;
+  queue = newQueue;
+  Chunk** newList = realloc(visibleList, newCapacity * sizeof(Chunk*));
+  if (!newList) return false;
+  visibleList = newList;
+  listCapacity = newCapacity;
+  return true;
+}
+
+static bool ChunkInFrustum(const Frustum* frustum, const Chunk* chunk)
+{
+  if (!frustum) return true;
+
+  const Vector3 min = {(float)chunk->position.x * CHUNK_SIZE,
+                       (float)chunk->position.y * CHUNK_SIZE,
+                       (float)chunk->position.z * CHUNK_SIZE};
+  const Vector3 max = {min.x + CHUNK_SIZE, min.y + CHUNK_SIZE,
+                       min.z + CHUNK_SIZE};
+  return FrustumIntersectsBox(frustum, (BoundingBox){min, max});
+}
+
+Chunk* const* BuildVisibleChunkList(const ChunkHashMap* chunks,
+                                    const Frustum* frustum,
+                                    const Vector3 cameraPosition, int* count)
+{
+  cullStats = (CaveCullStats){0};
+  *count = 0;
+
+  const ChunkKey startKey = {
+    (int)floorf(cameraPosition.x / CHUNK_SIZE),
+    (int)floorf(cameraPosition.y / CHUNK_SIZE),
+    (int)floorf(cameraPosition.z / CHUNK_SIZE)};
+  Chunk* start = ChunkHashMapGet(chunks, startKey);
+  if (!start)
+  {
+    Chunk* const* list =
+      BuildChunkDrawList(chunks, frustum, cameraPosition, count);
+    cullStats.drawn = *count;
+    return list;
+  }
+  if (!ReserveLists((int)ChunkHashMapSize(chunks))) return visibleList;
+
+  // Stamps mark the chunks already queued this walk, 0 is never used so
+  // fresh chunks don't look visited
+  if (++walkStamp == 0) walkStamp = 1;
+  start->cullStamp = walkStamp;
+  queue[0] = (VisitStep){start, -1, 0};
+  int head = 0;
+  int tail = 1;
+
+  // Breadth first, so chunks are reached in order of distance
+  while (head < tail)
+  {
+    const VisitStep step = queue[head++];
+    const Chunk* chunk = step.chunk;
+    cullStats.visited++;
+    if (chunk->mesh.page) visibleList[(*count)++] = step.chunk;
+
+    for (Face face = 0; face < 6; face++)
+    {
+      // Turning back can't find anything the walk hasn't seen from closer
+      if (step.travelled & 1 << OppositeFace(face)) continue;
+      if (step.entry >= 0 &&
+          !FacesConnected(chunk->faceConnections, (Face)step.entry, face))
+        continue;
+
+      const ChunkKey key = {chunk->position.x + faceSteps[face].x,
+                            chunk->position.y + faceSteps[face].y,
+                            chunk->position.z + faceSteps[face].z};
+      Chunk* neighbor = ChunkHashMapGet(chunks, key);
+      if (!neighbor || neighbor->cullStamp == walkStamp) continue;
+
+      // Chunks outside of the frustum stay outside whichever way they're
+      // reached, so they're marked too
+      neighbor->cullStamp = walkStamp;
+      if (!ChunkInFrustum(frustum, neighbor)) continue;
+      queue[tail++] = (VisitStep){neighbor, (signed char)OppositeFace(face),
+                                  step.travelled | 1 << face};
+    }
+  }
+
+  cullStats.drawn = *count;
+  return visibleList;
+}
+
+CaveCullStats GetCaveCullStats() { return cullStats; }
@@ -0,0 +1,73 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Cave culling: which chunks could possibly be seen from the camera chunk,
+// going by the air inside them. Each mesh job flood fills its chunk's air and
+// records which pairs of the six faces are joined through it. Drawing then
+// walks out from the camera chunk, only leaving a chunk through a face joined
+// to the one it came in by, and never turning back along an axis. Chunks the
+// walk can't reach, like the solid ground under the surface, aren't drawn.
+// Nothing here touches the GPU, so it works without a window.
+
+#ifndef CAVE_CULLING_H
+#define CAVE_CULLING_H
+
+#include <stdint.h>
+#include "chunkCulling.h"
+#include "chunkHashMap.h"
+#include "chunkMeshGeneration.h"
+#include "dataTypes.h"
+
+// Every one of the 15 face pairs joined, what empty chunks and chunks that
+// haven't been meshed yet start with
+#define ALL_FACES_CONNECTED 0x7FFF
+
+typedef struct CaveCullStats
+{
+  int visited; // Loaded chunks the walk reached
+  int drawn;   // Meshed chunks among them, the ones in the draw list
+} CaveCullStats;
+
+/* Whether faces a and b are joined, they must be different faces */
+bool FacesConnected(uint16_t connections, Face a, Face b);
+
+/* Flood fills the air of the snapshot's chunk, border excluded, and returns
+ * the face pairs some pocket of air touches both of. Safe to call from any
+ * thread */
+uint16_t ChunkFaceConnections(const ChunkMeshSnapshot* snapshot);
+
+/* Collect the meshed chunks the camera may see, walking out from the chunk
+ * it is in and skipping chunks outside of the frustum (none when it is NULL).
+ * Chunks come out nearest to the camera first, by walking distance. When the
+ * camera's chunk isn't loaded there is nothing to walk from and every chunk
+ * in the frustum is returned. The list is valid until the next call */
+Chunk* const* BuildVisibleChunkList(const ChunkHashMap* chunks,
+                                    const Frustum* frustum,
+                                    Vector3 cameraPosition, int* count);
+
+/* Counters of the last BuildVisibleChunkList */
+CaveCullStats GetCaveCullStats();
+
+#endif // CAVE_CULLING_H
@@ -0,0 +1,47 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "chunkBufferSizing.h"
+#include "chunkRenderer.h"
+
+int ChunkBufferCapacity(const int quadCount)
+{
+  if (quadCount <= 0 || quadCount > MAX_CHUNK_QUADS) return 0;
+
+  // Steps of 64, 96, 128, 192, 256... waste at most a third of a buffer
+  int capacity = MIN_CHUNK_BUFFER_QUADS;
+  while (capacity < quadCount)
+    capacity *= 2;
+  const int between = capacity / 4 * 3;
+  if (between >= quadCount && between >= MIN_CHUNK_BUFFER_QUADS)
+    capacity = between;
+  return capacity < MAX_CHUNK_QUADS ? capacity : MAX_CHUNK_QUADS;
+}
+
+bool CanReuseChunkBuffer(const int capacity, const int quadCount)
+{
+  if (quadCount <= 0 || quadCount > capacity) return false;
+  return ChunkBufferCapacity(quadCount) * 4 > capacity;
+}
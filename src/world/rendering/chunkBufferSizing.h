@@ -0,0 +1,51 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Sizing of chunk vertex buffers on the GPU. Buffers are allocated in capacity
+// classes so a remeshed chunk can usually update its buffer in place instead
+// of creating a new one. Nothing here touches the GPU, so it works without a
+// window.
+
+#ifndef CHUNK_BUFFER_SIZING_H
+#define CHUNK_BUFFER_SIZING_H
+
+#include <stdbool.h>
+
+// Smallest buffer a chunk gets, in quads
+#define MIN_CHUNK_BUFFER_QUADS 64
+
+/* Quads a buffer holding quadCount quads is allocated for: a power of two, or
+ * halfway between two, no smaller than MIN_CHUNK_BUFFER_QUADS and no larger
+ * than MAX_CHUNK_QUADS. Returns 0 for meshes that can't be uploaded */
+int ChunkBufferCapacity(int quadCount);
+
+/* Whether a buffer of capacity quads can be updated in place with quadCount
+ * quads. It can't when the mesh doesn't fit, and shouldn't when the mesh has
+ * shrunk to a quarter of the buffer or less, so memory of chunks that were
+ * dug out is given back. Anything in between keeps its buffer, which stops
+ * chunks edited back and forth from reallocating every time */
+bool CanReuseChunkBuffer(int capacity, int quadCount);
+
+#endif // CHUNK_BUFFER_SIZING_H
@@ -0,0 +1,183 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "chunkCulling.h"
+#include <stdlib.h>
+#include <string.h>
+#include "raymath.h"
+#include "rlgl.h"
+#include "settings.h"
+
+// Meshed chunk waiting to be sorted, key grows with distance to the camera
+typedef struct DrawCandidate
+{
+  Chunk* chunk;
+  int key;
+} DrawCandidate;
+
+// Buffers reused from frame to frame
+static DrawCandidate* candidates = NULL;
+static Chunk** drawList = NULL;
+static int drawListCapacity = 0;
+static int* bucketStarts = NULL;
+static int bucketCapacity = 0;
+
+static ChunkCullStats cullStats = {0};
+
+static Vector4 MakePlane(const float x, const float y, const float z,
+                         const float w)
+{
+  return (Vector4){x, y, z, w};
+}
+
+Frustum FrustumFromMatrix(const Matrix m)
+{
+  // Clip space is row . (x, y, z, 1) per row of the matrix, a point is inside
+  // when -w <= x, y, z <= w, so each plane is the w row plus or minus another
+  Frustum frustum;
+  frustum.planes[0] = MakePlane(m.m3 + m.m0, m.m7 + m.m4, m.m11 + m.m8,
+                                m.m15 + m.m12); // Left
+  frustum.planes[1] = MakePlane(m.m3 - m.m0, m.m7 - m.m4, m.m11 - m.m8,
+                                m.m15 - m.m12); // Right
+  frustum.planes[2] = MakePlane(m.m3 + m.m1, m.m7 + m.m5, m.m11 + m.m9,
+                                m.m15 + m.m13); // Bottom
+  frustum.planes[3] = MakePlane(m.m3 - m.m1, m.m7 - m.m5, m.m11 - m.m9,
+                                m.m15 - m.m13); // Top
+  frustum.planes[4] = MakePlane(m.m3 + m.m2, m.m7 + m.m6, m.m11 + m.m10,
+                                m.m15 + m.m14); // Near
+  frustum.planes[5] = MakePlane(m.m3 - m.m2, m.m7 - m.m6, m.m11 - m.m10,
+                                m.m15 - m.m14); // Far
+  return frustum;
+}
+
+Frustum FrustumFromCamera(const Camera3D camera, const float aspect)
+{
+  const Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+  const Matrix projection =
+    MatrixPerspective(camera.fovy * DEG2RAD, aspect, RL_CULL_DISTANCE_NEAR,
+                      RL_CULL_DISTANCE_FAR);
+  return FrustumFromMatrix(MatrixMultiply(view, projection));
+}
+
+bool FrustumIntersectsBox(const Frustum* frustum, const BoundingBox box)
+{
+  for (int i = 0; i < 6; i++)
+  {
+    // Only the corner furthest along the plane normal needs checking
+    const Vector4 plane = frustum->planes[i];
+    const float x = plane.x >= 0.0f ? box.max.x : box.min.x;
+    const float y = plane.y >= 0.0f ? box.max.y : box.min.y;
+    const float z = plane.z >= 0.0f ? box.max.z : box.min.z;
+    if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f) return false;
+  }
+  return true;
+}
+
+static bool ReserveDrawList(const int count)
+{
+  if (count <= drawListCapacity) return true;
+
+  int newCapacity = drawListCapacity > 0 ? drawListCapacity : 256;
+  while (newCapacity < count)
+    newCapacity *= 2;
+
+  DrawCandidate* newCandidates =
+    realloc(candidates, newCapacity * sizeof(DrawCandidate));
+  if (!newCandidates) return false;
+  candidates = newCandidates;
+  Chunk** newDrawList = realloc(drawList, newCapacity * sizeof(Chunk*));
+  if (!newDrawList) return false;
+  drawList = newDrawList;
+  drawListCapacity = newCapacity;
+  return true;
+}
+
+static bool ReserveBuckets(const int count)
+{
+  if (count <= bucketCapacity) return true;
+
+  int* newBuckets = realloc(bucketStarts, count * sizeof(int));
+  if (!newBuckets) return false;
+  bucketStarts = newBuckets;
+  bucketCapacity = count;
+  return true;
+}
+
+Chunk* const* BuildChunkDrawList(const ChunkHashMap* chunks,
+                                 const Frustum* frustum,
+                                 const Vector3 cameraPosition, int* count)
+{
+  cullStats = (ChunkCullStats){0};
+  *count = 0;
+  if (!ReserveDrawList((int)ChunkHashMapSize(chunks))) return drawList;
+
+  // Cull, keying what's left by squared distance in whole chunks, which is
+  // fine enough to cut overdraw and lets a counting sort do the ordering
+  const float chunkAreaInverse = 1.0f / (float)(CHUNK_SIZE * CHUNK_SIZE);
+  const float halfChunk = (float)CHUNK_SIZE * 0.5f;
+  int candidateCount = 0;
+  int maxKey = 0;
+  ChunkHashMapIterator it = ChunkHashMapIteratorCreate(chunks);
+  Chunk* chunk;
+  while (ChunkHashMapIteratorNext(&it, NULL, &chunk))
+  {
+    if (!chunk->mesh.page) continue;
+    cullStats.tested++;
+
+    const Vector3 min = {(float)chunk->position.x * CHUNK_SIZE,
+                         (float)chunk->position.y * CHUNK_SIZE,
+                         (float)chunk->position.z * CHUNK_SIZE};
+    const Vector3 max = Vector3Add(min, (Vector3){CHUNK_SIZE, CHUNK_SIZE,
+                                                  CHUNK_SIZE});
+    if (frustum && !FrustumIntersectsBox(frustum, (BoundingBox){min, max}))
+    {
+      cullStats.culled++;
+      continue;
+    }
+
+    const Vector3 center =
+      Vector3Add(min, (Vector3){halfChunk, halfChunk, halfChunk});
+    const int key =
+      (int)(Vector3DistanceSqr(center, cameraPosition) * chunkAreaInverse);
+    candidates[candidateCount++] = (DrawCandidate){chunk, key};
+    if (key > maxKey) maxKey = key;
+  }
+
+  // Counting sort, nearest bucket first
+  if (!ReserveBuckets(maxKey + 2)) return drawList;
+  memset(bucketStarts, 0, (maxKey + 2) * sizeof(int));
+  for (int i = 0; i < candidateCount; i++)
+    bucketStarts[candidates[i].key + 1]++;
+  for (int key = 1; key <= maxKey + 1; key++)
+    bucketStarts[key] += bucketStarts[key - 1];
+  for (int i = 0; i < candidateCount; i++)
+    drawList[bucketStarts[candidates[i].key]++] = candidates[i].chunk;
+
+  cullStats.drawn = candidateCount;
+  *count = candidateCount;
+  return drawList;
+}
+
+ChunkCullStats GetChunkCullStats() { return cullStats; }
@@ -0,0 +1,70 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// CPU side visibility for chunk drawing: view frustum tests against chunk
+// bounds and a front to back draw order. Nothing here touches the GPU, so it
+// works without a window.
+
+#ifndef CHUNK_CULLING_H
+#define CHUNK_CULLING_H
+
+#include "chunkHashMap.h"
+#include "dataTypes.h"
+
+// Planes point inwards, xyz is the normal and w the offset, so a point p is
+// inside a plane when dot(xyz, p) + w >= 0
+typedef struct Frustum
+{
+  Vector4 planes[6]; // Left, right, bottom, top, near, far
+} Frustum;
+
+typedef struct ChunkCullStats
+{
+  int tested; // Meshed chunks checked against the frustum
+  int culled; // Chunks skipped for being outside of it
+  int drawn;  // Chunks that made it into the draw list
+} ChunkCullStats;
+
+/* Frustum of a combined view projection matrix, as in
+ * MatrixMultiply(view, projection) */
+Frustum FrustumFromMatrix(Matrix viewProjection);
+
+/* Frustum of a perspective camera, matching what BeginMode3D sets up */
+Frustum FrustumFromCamera(Camera3D camera, float aspect);
+
+/* Conservative, boxes near a corner of the frustum may pass without being
+ * visible, but visible boxes never fail */
+bool FrustumIntersectsBox(const Frustum* frustum, BoundingBox box);
+
+/* Collect the meshed chunks that intersect the frustum (all of them when it is
+ * NULL), nearest to the camera first. The list is valid until the next call */
+Chunk* const* BuildChunkDrawList(const ChunkHashMap* chunks,
+                                 const Frustum* frustum, Vector3 cameraPosition,
+                                 int* count);
+
+/* Counters of the last BuildChunkDrawList */
+ChunkCullStats GetChunkCullStats();
+
+#endif // CHUNK_CULLING_H
@@ -0,0 +1,214 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "chunkRenderer.h"
+#include <stdlib.h>
+#include "raymath.h"
+#include "rlgl.h"
+
+// Every chunk vertex is a single 32 bit word, read by the shader as 4 bytes
+// (see PACK_CHUNK_VERTEX). Positions are relative to the draw region the
+// vertex is in. Quads are 4 vertices and share one index buffer
+static const char* chunkVertexShader =
+  "#version 330\n"
+  "layout(location = 0) in vec4 vertexData;\n"
+  "uniform mat4 mvp;\n"
+  "uniform vec3 regionOffset;\n"
+  "uniform vec4 voxelColors[16];\n"
+  "uniform float faceShades[6];\n"
+  "out vec4 fragColor;\n"
+  "void main()\n"
+  "{\n"
+  "  uvec4 bytes = uvec4(vertexData);\n"
+  "  uint packed = bytes.x | (bytes.y << 8u) | (bytes.z << 16u) |\n"
+  "                (bytes.w << 24u);\n"
+  "  vec3 position = vec3(float(packed & 127u),\n"
+  "                       float((packed >> 7u) & 127u),\n"
+  "                       float((packed >> 14u) & 127u));\n"
+  "  uint face = (packed >> 21u) & 7u;\n"
+  "  uint type = min(packed >> 24u, 15u);\n"
+  "  vec4 color = voxelColors[type];\n"
+  "  fragColor = vec4(color.rgb * faceShades[face], color.a);\n"
+  "  gl_Position = mvp * vec4(position + regionOffset, 1.0);\n"
+  "}\n";
+
+static const char* chunkFragmentShader =
+  "#version 330\n"
+  "in vec4 fragColor;\n"
+  "out vec4 finalColor;\n"
+  "void main() { finalColor = fragColor; }\n";
+
+static const Color voxelColors[] = {
+  {0, 0, 0, 0},        // AIR = 0
+  {150, 75, 0, 255},   // DIRT = 1
+  {46, 125, 50, 255},  // GRASS = 2
+  {100, 100, 100, 255} // STONE = 3
+};
+
+// Indexed by Face
+static const float faceShades[6] = {1.0f, 0.5f, 0.7f, 0.75f, 0.75f, 0.75f};
+
+static Shader chunkShader = {0};
+static int mvpLocation = -1;
+static int regionOffsetLocation = -1;
+static unsigned int quadIndexBuffer = 0;
+// Source of the zeros written over quads that aren't in use anymore
+static uint32_t* zeroQuads = NULL;
+static bool wireframeActive = false;
+
+void InitChunkRenderer()
+{
+  chunkShader = LoadShaderFromMemory(chunkVertexShader, chunkFragmentShader);
+  mvpLocation = GetShaderLocation(chunkShader, "mvp");
+  regionOffsetLocation = GetShaderLocation(chunkShader, "regionOffset");
+
+  // Colors and shades never change, so they only need setting once
+  const int colorCount = sizeof(voxelColors) / sizeof(voxelColors[0]);
+  Vector4 colors[sizeof(voxelColors) / sizeof(voxelColors[0])];
+  for (int i = 0; i < colorCount; i++)
+    colors[i] = ColorNormalize(voxelColors[i]);
+  SetShaderValueV(chunkShader, GetShaderLocation(chunkShader, "voxelColors"),
+                  colors, SHADER_UNIFORM_VEC4, colorCount);
+  SetShaderValueV(chunkShader, GetShaderLocation(chunkShader, "faceShades"),
+                  faceShades, SHADER_UNIFORM_FLOAT, 6);
+
+  // Every quad is drawn as (0, 1, 2) (0, 2, 3), the same as the face tables.
+  // It's loaded as a plain buffer so no vertex array has to be bound yet, each
+  // chunk's vertex array binds it as its element buffer
+  unsigned short* indices = malloc(MAX_CHUNK_QUADS * 6 * sizeof(unsigned short));
+  if (!indices)
+  {
+    TraceLog(LOG_ERROR, "Failed to allocate chunk index buffer");
+    return;
+  }
+  for (int quad = 0; quad < MAX_CHUNK_QUADS; quad++)
+  {
+    const unsigned short first = (unsigned short)(quad * 4);
+    indices[quad * 6] = first;
+    indices[quad * 6 + 1] = first + 1;
+    indices[quad * 6 + 2] = first + 2;
+    indices[quad * 6 + 3] = first;
+    indices[quad * 6 + 4] = first + 2;
+    indices[quad * 6 + 5] = first + 3;
+  }
+  quadIndexBuffer = rlLoadVertexBuffer(
+    indices, MAX_CHUNK_QUADS * 6 * sizeof(unsigned short), false);
+  free(indices);
+
+  zeroQuads = calloc(MAX_CHUNK_QUADS * 4, sizeof(uint32_t));
+  if (!zeroQuads) TraceLog(LOG_ERROR, "Failed to allocate zeroed quads");
+}
+
+void EndChunkRenderer()
+{
+  if (quadIndexBuffer) rlUnloadVertexBuffer(quadIndexBuffer);
+  quadIndexBuffer = 0;
+  free(zeroQuads);
+  zeroQuads = NULL;
+  UnloadShader(chunkShader);
+  chunkShader = (Shader){0};
+}
+
+bool LoadRegionGpuBuffer(RegionGpuBuffer* buffer, const int quadCapacity)
+{
+  *buffer = (RegionGpuBuffer){0};
+  if (!zeroQuads || quadCapacity <= 0 || quadCapacity > MAX_CHUNK_QUADS)
+    return false;
+
+  buffer->vaoId = rlLoadVertexArray();
+  if (!buffer->vaoId)
+  {
+    TraceLog(LOG_ERROR, "Failed to create region vertex array");
+    return false;
+  }
+
+  rlEnableVertexArray(buffer->vaoId);
+  buffer->vboId = rlLoadVertexBuffer(
+    zeroQuads, quadCapacity * 4 * sizeof(uint32_t), true);
+  rlSetVertexAttribute(0, 4, RL_UNSIGNED_BYTE, false, 0, 0);
+  rlEnableVertexAttribute(0);
+  rlEnableVertexBufferElement(quadIndexBuffer);
+  rlDisableVertexArray();
+
+  if (!buffer->vboId)
+  {
+    TraceLog(LOG_ERROR, "Failed to create region vertex buffer");
+    UnloadRegionGpuBuffer(buffer);
+    return false;
+  }
+  buffer->quadCapacity = quadCapacity;
+  return true;
+}
+
+void UnloadRegionGpuBuffer(RegionGpuBuffer* buffer)
+{
+  if (buffer->vaoId) rlUnloadVertexArray(buffer->vaoId);
+  if (buffer->vboId) rlUnloadVertexBuffer(buffer->vboId);
+  *buffer = (RegionGpuBuffer){0};
+}
+
+void UpdateRegionGpuBuffer(const RegionGpuBuffer* buffer, const int firstQuad,
+                           const uint32_t* vertices, const int quadCount)
+{
+  if (quadCount <= 0) return;
+  if (!vertices) vertices = zeroQuads;
+  rlUpdateVertexBuffer(buffer->vboId, vertices,
+                       quadCount * 4 * sizeof(uint32_t),
+                       firstQuad * 4 * sizeof(uint32_t));
+}
+
+void BeginChunkRendering(const bool wireframe)
+{
+  // Anything raylib has batched up so far has to be drawn first
+  rlDrawRenderBatchActive();
+
+  rlEnableShader(chunkShader.id);
+  const Matrix mvp =
+    MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+  rlSetUniformMatrix(mvpLocation, mvp);
+
+  wireframeActive = wireframe;
+  if (wireframeActive) rlEnableWireMode();
+}
+
+void DrawRegionGpuBuffer(const RegionGpuBuffer* buffer, const int firstQuad,
+                         const int quadCount, const Vector3 position)
+{
+  if (!buffer->vaoId || quadCount <= 0) return;
+
+  // The shared indices repeat the same pattern every quad, so starting at
+  // quad n's indices draws from its vertices on
+  rlSetUniform(regionOffsetLocation, &position, SHADER_UNIFORM_VEC3, 1);
+  rlEnableVertexArray(buffer->vaoId);
+  rlDrawVertexArrayElements(firstQuad * 6, quadCount * 6, NULL);
+}
+
+void EndChunkRendering()
+{
+  rlDisableVertexArray();
+  rlDisableShader();
+  if (wireframeActive) rlDisableWireMode();
+  wireframeActive = false;
+}
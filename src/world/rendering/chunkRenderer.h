@@ -0,0 +1,65 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#ifndef CHUNK_RENDERER_H
+#define CHUNK_RENDERER_H
+
+#include <stdint.h>
+#include "dataTypes.h"
+
+// Most quads a single chunk mesh can have, limited by 16 bit indices
+#define MAX_CHUNK_QUADS (65536 / 4)
+
+/* Load the chunk shader and the index buffer shared by every chunk mesh,
+ * needs an active window */
+void InitChunkRenderer();
+void EndChunkRenderer();
+
+// Vertex buffer holding the meshes of many chunks, see drawRegions
+typedef struct RegionGpuBuffer
+{
+  unsigned int vaoId;
+  unsigned int vboId;
+  int quadCapacity;
+} RegionGpuBuffer;
+
+/* Create a buffer of quadCapacity quads, all of them zero. Zeroed quads are
+ * degenerate, so unused parts of a buffer can be drawn without showing up */
+bool LoadRegionGpuBuffer(RegionGpuBuffer* buffer, int quadCapacity);
+void UnloadRegionGpuBuffer(RegionGpuBuffer* buffer);
+
+/* Write packed vertices (4 per quad) starting at firstQuad, or zeros when
+ * vertices is NULL */
+void UpdateRegionGpuBuffer(const RegionGpuBuffer* buffer, int firstQuad,
+                           const uint32_t* vertices, int quadCount);
+
+/* Region buffers must be drawn between these, inside of a 3D mode. The
+ * quadCount quads from firstQuad on are drawn in a single call */
+void BeginChunkRendering(bool wireframe);
+void DrawRegionGpuBuffer(const RegionGpuBuffer* buffer, int firstQuad,
+                         int quadCount, Vector3 position);
+void EndChunkRendering();
+
+#endif // CHUNK_RENDERER_H
@@ -0,0 +1,471 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "drawRegions.h"
+#include <stdlib.h>
+#include "chunkBufferSizing.h"
+#include "chunkMeshGeneration.h"
+#include "map.h"
+#include "raymath.h"
+#include "settings.h"
+
+#define DRAW_REGION_VOXELS (DRAW_REGION_SIZE * CHUNK_SIZE)
+
+// Page waiting to be sorted, by squared distance to the camera
+typedef struct PageCandidate
+{
+  DrawRegionPage* page;
+  float distance;
+} PageCandidate;
+
+// Range of a chunk on its way into a run, order is where the chunk sits in
+// the list of chunks to draw
+typedef struct RunCandidate
+{
+  const DrawRegionPage* page;
+  int firstQuad;
+  int quadCount;
+  int quadSpan; // Quads up to the end of the range, unused ones are zeroed
+  int order;
+} RunCandidate;
+
+// First page of every region with meshes in it
+static Map* regions = NULL;
+static DrawRegionPage* pages = NULL;
+static DrawRegionPage* sparePages = NULL;
+static DrawRegionStats stats = {0};
+
+// Buffers reused from frame to frame
+static PageCandidate* candidates = NULL;
+static DrawRegionPage** drawList = NULL;
+static int drawListCapacity = 0;
+static RunCandidate* runCandidates = NULL;
+static DrawRegionRun* runList = NULL;
+static int runListCapacity = 0;
+
+static int FloorDivide(const int value, const int divisor)
+{
+  return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+Vector3I DrawRegionOfChunk(const Vector3I chunkPosition)
+{
+  return (Vector3I){FloorDivide(chunkPosition.x, DRAW_REGION_SIZE),
+                    FloorDivide(chunkPosition.y, DRAW_REGION_SIZE),
+                    FloorDivide(chunkPosition.z, DRAW_REGION_SIZE)};
+}
+
+void OffsetChunkVertices(uint32_t* vertices, const int vertexCount,
+                         const Vector3I chunkPosition)
+{
+  // Axes are packed in their own bits and a chunk never reaches the end of
+  // its region, so one addition moves all three at once
+  const Vector3I region = DrawRegionOfChunk(chunkPosition);
+  const uint32_t offset = PACK_CHUNK_VERTEX(
+    (chunkPosition.x - region.x * DRAW_REGION_SIZE) * CHUNK_SIZE,
+    (chunkPosition.y - region.y * DRAW_REGION_SIZE) * CHUNK_SIZE,
+    (chunkPosition.z - region.z * DRAW_REGION_SIZE) * CHUNK_SIZE, 0, 0);
+  if (offset == 0) return;
+  for (int i = 0; i < vertexCount; i++)
+    vertices[i] += offset;
+}
+
+// Pages
+
+static DrawRegionPage* CreatePage(const Vector3I region, const int capacity)
+{
+  // Spares are all standard sized and already zeroed
+  DrawRegionPage* page = NULL;
+  if (capacity <= DRAW_REGION_PAGE_QUADS && sparePages)
+  {
+    page = sparePages;
+    sparePages = page->next;
+    stats.spareCount--;
+  }
+  else
+  {
+    page = calloc(1, sizeof(DrawRegionPage));
+    if (!page) return NULL;
+
+    const int quadCapacity =
+      capacity > DRAW_REGION_PAGE_QUADS ? capacity : DRAW_REGION_PAGE_QUADS;
+    page->ranges = RangeAllocatorCreate(quadCapacity);
+    if (!page->ranges || !LoadRegionGpuBuffer(&page->buffer, quadCapacity))
+    {
+      TraceLog(LOG_ERROR, "Failed to create draw region page");
+      RangeAllocatorDestroy(page->ranges);
+      free(page);
+      return NULL;
+    }
+  }
+
+  page->region = region;
+  page->chunkCount = 0;
+  page->previous = NULL;
+  page->next = pages;
+  if (pages) pages->previous = page;
+  pages = page;
+  stats.pageCount++;
+  stats.quadCapacity += page->buffer.quadCapacity;
+  return page;
+}
+
+static void DeletePage(DrawRegionPage* page)
+{
+  UnloadRegionGpuBuffer(&page->buffer);
+  RangeAllocatorDestroy(page->ranges);
+  free(page);
+}
+
+// Unlinks a page nothing is in anymore, keeping it as a spare if there's room
+static void RetirePage(DrawRegionPage* page)
+{
+  DrawRegionPage* first = NULL;
+  MapGet(regions, &page->region, &first);
+  if (first == page)
+  {
+    if (page->nextInRegion)
+      MapPut(regions, &page->region, &page->nextInRegion);
+    else
+      MapRemove(regions, &page->region);
+  }
+  else
+  {
+    DrawRegionPage* other = first;
+    while (other && other->nextInRegion != page)
+      other = other->nextInRegion;
+    if (other) other->nextInRegion = page->nextInRegion;
+  }
+  page->nextInRegion = NULL;
+
+  if (page->previous)
+    page->previous->next = page->next;
+  else
+    pages = page->next;
+  if (page->next) page->next->previous = page->previous;
+  stats.pageCount--;
+  stats.quadCapacity -= page->buffer.quadCapacity;
+
+  if (page->buffer.quadCapacity == DRAW_REGION_PAGE_QUADS &&
+      stats.spareCount < DRAW_REGION_SPARE_PAGES)
+  {
+    page->previous = NULL;
+    page->next = sparePages;
+    sparePages = page;
+    stats.spareCount++;
+    return;
+  }
+  DeletePage(page);
+}
+
+// A range of capacity quads in one of the region's pages, adding a page if
+// none of them has room
+static DrawRegionPage* AllocateInRegion(const Vector3I region,
+                                        const int capacity, int* firstQuad)
+{
+  if (!regions) regions = MapCreate(sizeof(Vector3I), sizeof(DrawRegionPage*),
+                                    MHVI, MCV3);
+  if (!regions) return NULL;
+
+  DrawRegionPage* first = NULL;
+  MapGet(regions, &region, &first);
+  for (DrawRegionPage* page = first; page; page = page->nextInRegion)
+  {
+    *firstQuad = RangeAllocate(page->ranges, capacity);
+    if (*firstQuad >= 0) return page;
+  }
+
+  DrawRegionPage* page = CreatePage(region, capacity);
+  if (!page) return NULL;
+  if (!MapPut(regions, &region, &page))
+  {
+    RetirePage(page);
+    return NULL;
+  }
+  page->nextInRegion = first;
+  *firstQuad = RangeAllocate(page->ranges, capacity);
+  return page;
+}
+
+// Zeroes the chunk's quads and gives its range back to the page
+static void ReleaseMeshRange(ChunkGpuMesh* mesh)
+{
+  DrawRegionPage* page = mesh->page;
+  UpdateRegionGpuBuffer(&page->buffer, mesh->firstQuad, NULL, mesh->quadCount);
+  RangeRelease(page->ranges, mesh->firstQuad, mesh->quadCapacity);
+  *mesh = (ChunkGpuMesh){0};
+  if (--page->chunkCount == 0) RetirePage(page);
+}
+
+bool UploadChunkToRegion(ChunkGpuMesh* mesh, const Vector3I chunkPosition,
+                         uint32_t* vertices, const int quadCount)
+{
+  const int capacity = ChunkBufferCapacity(quadCount);
+  if (capacity == 0)
+  {
+    RemoveChunkFromRegion(mesh);
+    return false;
+  }
+  OffsetChunkVertices(vertices, quadCount * 4, chunkPosition);
+
+  // Remeshed chunks mostly fit in the range they already have, only the
+  // quads the mesh doesn't cover anymore need zeroing
+  if (mesh->page && CanReuseChunkBuffer(mesh->quadCapacity, quadCount))
+  {
+    UpdateRegionGpuBuffer(&mesh->page->buffer, mesh->firstQuad, vertices,
+                          quadCount);
+    UpdateRegionGpuBuffer(&mesh->page->buffer, mesh->firstQuad + quadCount,
+                          NULL, mesh->quadCount - quadCount);
+    mesh->quadCount = quadCount;
+    return true;
+  }
+
+  // Otherwise it moves to a new range, which is still all zeros. The new
+  // range is counted first so leaving the old one can't retire its page
+  int firstQuad = -1;
+  DrawRegionPage* page =
+    AllocateInRegion(DrawRegionOfChunk(chunkPosition), capacity, &firstQuad);
+  if (page) page->chunkCount++;
+  RemoveChunkFromRegion(mesh);
+  if (!page) return false;
+
+  UpdateRegionGpuBuffer(&page->buffer, firstQuad, vertices, quadCount);
+  *mesh = (ChunkGpuMesh){page, firstQuad, quadCount, capacity};
+  return true;
+}
+
+void RemoveChunkFromRegion(ChunkGpuMesh* mesh)
+{
+  if (mesh->page) ReleaseMeshRange(mesh);
+}
+
+int DrawRegionPageQuads(const DrawRegionPage* page)
+{
+  return RangeAllocatorEnd(page->ranges);
+}
+
+// Drawing
+
+static bool ReserveDrawList(const int count)
+{
+  if (count <= drawListCapacity) return true;
+
+  int newCapacity = drawListCapacity > 0 ? drawListCapacity : 64;
+  while (newCapacity < count)
+    newCapacity *= 2;
+
+  PageCandidate* newCandidates =
+    realloc(candidates, newCapacity * sizeof(PageCandidate));
+  if (!newCandidates) return false;
+  candidates = newCandidates;
+  DrawRegionPage** newDrawList =
+    realloc(drawList, newCapacity * sizeof(DrawRegionPage*));
+  if (!newDrawList) return false;
+  drawList = newDrawList;
+  drawListCapacity = newCapacity;
+  return true;
+}
+
+static int CompareCandidates(const void* a, const void* b)
+{
+  const float distanceA = ((const PageCandidate*)a)->distance;
+  const float distanceB = ((const PageCandidate*)b)->distance;
+  return (distanceA > distanceB) - (distanceA < distanceB);
+}
+
+DrawRegionPage* const* BuildRegionDrawList(const Frustum* frustum,
+                                           const Vector3 cameraPosition,
+                                           int* count)
+{
+  stats.tested = stats.culled = stats.drawn = 0;
+  *count = 0;
+  if (!ReserveDrawList(stats.pageCount)) return drawList;
+
+  // There are few enough pages that a plain sort does the ordering
+  const float halfRegion = (float)DRAW_REGION_VOXELS * 0.5f;
+  int candidateCount = 0;
+  for (DrawRegionPage* page = pages; page; page = page->next)
+  {
+    stats.tested++;
+    const Vector3 min = {(float)page->region.x * DRAW_REGION_VOXELS,
+                         (float)page->region.y * DRAW_REGION_VOXELS,
+                         (float)page->region.z * DRAW_REGION_VOXELS};
+    const Vector3 max = Vector3Add(
+      min, (Vector3){DRAW_REGION_VOXELS, DRAW_REGION_VOXELS,
+                     DRAW_REGION_VOXELS});
+    if (frustum && !FrustumIntersectsBox(frustum, (BoundingBox){min, max}))
+    {
+      stats.culled++;
+      continue;
+    }
+
+    const Vector3 center =
+      Vector3Add(min, (Vector3){halfRegion, halfRegion, halfRegion});
+    candidates[candidateCount++] =
+      (PageCandidate){page, Vector3DistanceSqr(center, cameraPosition)};
+  }
+
+  if (candidateCount > 1)
+    qsort(candidates, candidateCount, sizeof(PageCandidate), CompareCandidates);
+  for (int i = 0; i < candidateCount; i++)
+    drawList[i] = candidates[i].page;
+
+  stats.drawn = candidateCount;
+  *count = candidateCount;
+  return drawList;
+}
+
+static bool ReserveRunList(const int count)
+{
+  if (count <= runListCapacity) return true;
+
+  int newCapacity = runListCapacity > 0 ? runListCapacity : 256;
+  while (newCapacity < count)
+    newCapacity *= 2;
+
+  RunCandidate* newCandidates =
+    realloc(runCandidates, newCapacity * sizeof(RunCandidate));
+  if (!newCandidates) return false;
+  runCandidates = newCandidates;
+  DrawRegionRun* newRunList =
+    realloc(runList, newCapacity * sizeof(DrawRegionRun));
+  if (!newRunList) return false;
+  runList = newRunList;
+  runListCapacity = newCapacity;
+  return true;
+}
+
+// By page, then by where the range starts in it
+static int CompareRanges(const void* a, const void* b)
+{
+  const RunCandidate* rangeA = a;
+  const RunCandidate* rangeB = b;
+  const uintptr_t pageA = (uintptr_t)rangeA->page;
+  const uintptr_t pageB = (uintptr_t)rangeB->page;
+  if (pageA != pageB) return (pageA > pageB) - (pageA < pageB);
+  return (rangeA->firstQuad > rangeB->firstQuad) -
+         (rangeA->firstQuad < rangeB->firstQuad);
+}
+
+static int CompareRuns(const void* a, const void* b)
+{
+  const RunCandidate* runA = a;
+  const RunCandidate* runB = b;
+  if (runA->order != runB->order)
+    return (runA->order > runB->order) - (runA->order < runB->order);
+  return (runA->firstQuad > runB->firstQuad) -
+         (runA->firstQuad < runB->firstQuad);
+}
+
+const DrawRegionRun* BuildRegionRunList(Chunk* const* chunks,
+                                        const int chunkCount, int* count)
+{
+  stats.tested = stats.culled = stats.drawn = 0;
+  *count = 0;
+  if (!ReserveRunList(chunkCount)) return runList;
+
+  int rangeCount = 0;
+  for (int i = 0; i < chunkCount; i++)
+  {
+    const ChunkGpuMesh* mesh = &chunks[i]->mesh;
+    if (!mesh->page) continue;
+    runCandidates[rangeCount++] = (RunCandidate){
+      mesh->page, mesh->firstQuad, mesh->quadCount, mesh->quadCapacity, i};
+  }
+  if (rangeCount > 1)
+    qsort(runCandidates, rangeCount, sizeof(RunCandidate), CompareRanges);
+
+  // Merge ranges that follow each other in a page, runs are written over the
+  // ranges already looked at
+  int runCount = 0;
+  for (int first = 0, end; first < rangeCount; first = end)
+  {
+    const DrawRegionPage* page = runCandidates[first].page;
+    int pageOrder = runCandidates[first].order;
+    for (end = first + 1; end < rangeCount && runCandidates[end].page == page;
+         end++)
+    {
+      if (runCandidates[end].order < pageOrder)
+        pageOrder = runCandidates[end].order;
+    }
+
+    const int pageRuns = runCount;
+    for (int i = first; i < end; i++)
+    {
+      const RunCandidate range = runCandidates[i];
+      if (runCount > pageRuns)
+      {
+        RunCandidate* run = &runCandidates[runCount - 1];
+        if (range.firstQuad == run->firstQuad + run->quadSpan)
+        {
+          run->quadCount = range.firstQuad + range.quadCount - run->firstQuad;
+          run->quadSpan += range.quadSpan;
+          continue;
+        }
+      }
+      runCandidates[runCount] = range;
+      runCandidates[runCount++].order = pageOrder;
+    }
+  }
+
+  if (runCount > 1)
+    qsort(runCandidates, runCount, sizeof(RunCandidate), CompareRuns);
+  for (int i = 0; i < runCount; i++)
+  {
+    runList[i] = (DrawRegionRun){runCandidates[i].page,
+                                 runCandidates[i].firstQuad,
+                                 runCandidates[i].quadCount};
+  }
+
+  stats.drawn = runCount;
+  *count = runCount;
+  return runList;
+}
+
+DrawRegionStats GetDrawRegionStats() { return stats; }
+
+void FreeDrawRegions()
+{
+  while (sparePages)
+  {
+    DrawRegionPage* next = sparePages->next;
+    DeletePage(sparePages);
+    sparePages = next;
+  }
+  stats.spareCount = 0;
+
+  MapFree(regions);
+  regions = NULL;
+  free(candidates);
+  candidates = NULL;
+  free(drawList);
+  drawList = NULL;
+  drawListCapacity = 0;
+  free(runCandidates);
+  runCandidates = NULL;
+  free(runList);
+  runList = NULL;
+  runListCapacity = 0;
+}
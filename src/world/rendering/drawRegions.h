@@ -0,0 +1,116 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Chunk meshes are packed into vertex buffers shared by the chunks of a draw
+// region, a DRAW_REGION_SIZE^3 block of chunks, so a whole region is drawn in
+// a single call. Each chunk takes a range of quads in one of its region's
+// pages, sized by ChunkBufferCapacity and handed out by a RangeAllocator. A
+// remeshed chunk only rewrites its own range, in place when it still fits.
+// Quads outside of any range are kept zeroed, so a page can be drawn up to
+// its last range without showing what used to be there.
+
+#ifndef DRAW_REGIONS_H
+#define DRAW_REGIONS_H
+
+#include <stdint.h>
+#include "chunkCulling.h"
+#include "chunkRenderer.h"
+#include "dataTypes.h"
+#include "rangeAllocator.h"
+
+// Chunks along each axis of a draw region. Vertex positions have 7 bits, so a
+// region can't be more than 127 voxels across
+#define DRAW_REGION_SIZE 4
+// Quads in a page, chunks with more than this get a page of their own
+#define DRAW_REGION_PAGE_QUADS 8192
+// Empty pages kept for reuse instead of deleting their buffers
+#define DRAW_REGION_SPARE_PAGES 8
+
+typedef struct DrawRegionPage
+{
+  Vector3I region; // Chunk coordinates divided by DRAW_REGION_SIZE
+  RegionGpuBuffer buffer;
+  RangeAllocator* ranges; // Quads of the buffer in use by chunks
+  int chunkCount;
+  struct DrawRegionPage* nextInRegion; // Other pages of the same region
+  struct DrawRegionPage* previous;
+  struct DrawRegionPage* next;
+} DrawRegionPage;
+
+typedef struct DrawRegionStats
+{
+  int pageCount;          // Pages in use, spare ones not included
+  int spareCount;         // Empty pages kept for reuse
+  long long quadCapacity; // Quads over every page in use
+  int tested;             // Pages checked against the frustum
+  int culled;             // Pages skipped for being outside of it
+  int drawn;              // Draw calls of the last list built
+} DrawRegionStats;
+
+// Quads of a page drawn in one call, the ranges of neighboring chunks in the
+// buffer are merged into a single run
+typedef struct DrawRegionRun
+{
+  const DrawRegionPage* page;
+  int firstQuad;
+  int quadCount;
+} DrawRegionRun;
+
+/* Draw region of a chunk */
+Vector3I DrawRegionOfChunk(Vector3I chunkPosition);
+
+/* Move packed chunk vertices from chunk to draw region coordinates */
+void OffsetChunkVertices(uint32_t* vertices, int vertexCount,
+                         Vector3I chunkPosition);
+
+/* Put the chunk's packed vertices (4 per quad) into its draw region, replacing
+ * what the mesh held before. The vertices are moved to region coordinates in
+ * place. On failure the chunk is left without a mesh */
+bool UploadChunkToRegion(ChunkGpuMesh* mesh, Vector3I chunkPosition,
+                         uint32_t* vertices, int quadCount);
+
+/* Take the chunk's mesh out of its region, if it has one */
+void RemoveChunkFromRegion(ChunkGpuMesh* mesh);
+
+/* Collect the pages that intersect the frustum (all of them when it is NULL),
+ * nearest to the camera first. The list is valid until the next call */
+DrawRegionPage* const* BuildRegionDrawList(const Frustum* frustum,
+                                           Vector3 cameraPosition, int* count);
+
+/* Collect the runs drawing only the given chunks, for when most of a page
+ * isn't visible. Pages keep the order their first chunk has in the list. The
+ * list is valid until the next call */
+const DrawRegionRun* BuildRegionRunList(Chunk* const* chunks, int chunkCount,
+                                        int* count);
+
+/* Quads to draw of a page, everything past its last range is free */
+int DrawRegionPageQuads(const DrawRegionPage* page);
+
+DrawRegionStats GetDrawRegionStats();
+
+/* Delete the spare pages, every chunk must have been removed already */
+void FreeDrawRegions();
+
+#endif // DRAW_REGIONS_H
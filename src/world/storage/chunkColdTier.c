@@ -0,0 +1,184 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "chunkColdTier.h"
+#include <stdlib.h>
+#include <string.h>
+#include "chunkHashMap.h"
+#include "chunkStorage.h"
+#include "map.h"
+#include "regionFile.h"
+#include "settings.h"
+
+typedef struct ColdChunk
+{
+  ChunkKey key;
+  bool unsaved; // The region files don't have these voxels yet
+  size_t size;
+  struct ColdChunk* newer;
+  struct ColdChunk* older;
+  unsigned char payload[];
+} ColdChunk;
+
+static Map* coldChunks = NULL;
+// Most recently stored first, evicted from the back
+static ColdChunk* newest = NULL;
+static ColdChunk* oldest = NULL;
+static ChunkColdTierStats stats = {0, 0, COLD_TIER_BUDGET, 0, 0};
+
+static size_t ChunkKeyMapHash(const void* key)
+{
+  return ChunkKeyHash(*(const ChunkKey*)key);
+}
+
+static bool ChunkKeyMapEquals(const void* a, const void* b)
+{
+  return ChunkKeyEquals(*(const ChunkKey*)a, *(const ChunkKey*)b);
+}
+
+// What a cold chunk costs, including its map entry
+static size_t ColdChunkBytes(const ColdChunk* coldChunk)
+{
+  return sizeof(ColdChunk) + coldChunk->size + sizeof(MapEntry) +
+         sizeof(ChunkKey) + sizeof(ColdChunk*);
+}
+
+static void Unlink(ColdChunk* coldChunk)
+{
+  if (coldChunk->newer)
+    coldChunk->newer->older = coldChunk->older;
+  else
+    newest = coldChunk->older;
+  if (coldChunk->older)
+    coldChunk->older->newer = coldChunk->newer;
+  else
+    oldest = coldChunk->newer;
+}
+
+static void Remove(ColdChunk* coldChunk)
+{
+  Unlink(coldChunk);
+  MapRemove(coldChunks, &coldChunk->key);
+  stats.chunkCount--;
+  stats.bytes -= ColdChunkBytes(coldChunk);
+  free(coldChunk);
+}
+
+// Drops a chunk from the tier, writing an unsaved payload to its region file
+// first so the edits outlive the entry
+static void Evict(ColdChunk* coldChunk)
+{
+  if (coldChunk->unsaved && RegionStoreIsOpen() &&
+      !RegionStoreWrite(coldChunk->key.chunkX, coldChunk->key.chunkY,
+                        coldChunk->key.chunkZ, coldChunk->payload,
+                        coldChunk->size))
+  {
+    TraceLog(LOG_ERROR, "Failed to save chunk (%d, %d, %d)",
+             coldChunk->key.chunkX, coldChunk->key.chunkY,
+             coldChunk->key.chunkZ);
+  }
+  Remove(coldChunk);
+}
+
+bool ChunkColdTierStore(const Chunk* chunk)
+{
+  if (!coldChunks)
+  {
+    coldChunks = MapCreate(sizeof(ChunkKey), sizeof(ColdChunk*),
+                           ChunkKeyMapHash, ChunkKeyMapEquals);
+    if (!coldChunks) return false;
+  }
+
+  unsigned char payload[CHUNK_PAYLOAD_MAX_SIZE];
+  const size_t size =
+    ChunkStorageEncode(&chunk->voxels, payload, sizeof(payload));
+  if (!size) return false;
+  ColdChunk* coldChunk = malloc(sizeof(ColdChunk) + size);
+  if (!coldChunk) return false;
+  coldChunk->key = (ChunkKey){chunk->position.x, chunk->position.y,
+                              chunk->position.z};
+  coldChunk->unsaved = chunk->unsaved;
+  coldChunk->size = size;
+  memcpy(coldChunk->payload, payload, size);
+
+  // A chunk is only stored while loaded, so it can't already be in the tier
+  if (!MapPut(coldChunks, &coldChunk->key, &coldChunk))
+  {
+    free(coldChunk);
+    return false;
+  }
+  coldChunk->newer = NULL;
+  coldChunk->older = newest;
+  if (newest)
+    newest->newer = coldChunk;
+  else
+    oldest = coldChunk;
+  newest = coldChunk;
+  stats.chunkCount++;
+  stats.bytes += ColdChunkBytes(coldChunk);
+
+  while (stats.bytes > stats.budget && oldest)
+    Evict(oldest);
+  return true;
+}
+
+bool ChunkColdTierRestore(Chunk* chunk)
+{
+  const ChunkKey key = {chunk->position.x, chunk->position.y,
+                        chunk->position.z};
+  ColdChunk* coldChunk;
+  if (!coldChunks || !MapGet(coldChunks, &key, &coldChunk))
+  {
+    stats.misses++;
+    return false;
+  }
+
+  // A payload that fails to decode is dropped, the chunk loads like normal
+  const bool restored =
+    ChunkStorageDecode(coldChunk->payload, coldChunk->size, &chunk->voxels);
+  if (restored)
+  {
+    chunk->unsaved = coldChunk->unsaved;
+    stats.hits++;
+  }
+  else
+  {
+    TraceLog(LOG_ERROR, "Dropping corrupt cold chunk (%d, %d, %d)", key.chunkX,
+             key.chunkY, key.chunkZ);
+    stats.misses++;
+  }
+  Remove(coldChunk);
+  return restored;
+}
+
+void ChunkColdTierClear(void)
+{
+  while (oldest)
+    Evict(oldest);
+  MapFree(coldChunks);
+  coldChunks = NULL;
+}
+
+ChunkColdTierStats ChunkColdTierGetStats(void) { return stats; }
@@ -0,0 +1,62 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Chunks that were just unloaded are kept compressed in memory for a while,
+// so stepping back and forth over a chunk border restores them with a quick
+// decompress instead of a generation job or a region file read. Least
+// recently unloaded chunks are evicted once the tier goes over its budget,
+// writing out any unsaved changes to the region files on the way.
+// Main thread only.
+
+#ifndef CHUNK_COLD_TIER_H
+#define CHUNK_COLD_TIER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "dataTypes.h"
+
+typedef struct ChunkColdTierStats
+{
+  int chunkCount;
+  size_t bytes;     // Payloads plus bookkeeping
+  size_t budget;    // Bytes kept before evicting
+  long long hits;   // Chunk requests restored from the tier
+  long long misses; // Chunk requests that had to load or generate
+} ChunkColdTierStats;
+
+/* Keep a compressed copy of a chunk about to be unloaded. Returns false if it
+ * couldn't, leaving saving it to the caller */
+bool ChunkColdTierStore(const Chunk* chunk);
+
+/* Restore the voxels of the chunk at chunk->position, removing it from the
+ * tier. Returns false if the chunk isn't in the tier */
+bool ChunkColdTierRestore(Chunk* chunk);
+
+/* Save what's unsaved to the region files and empty the tier */
+void ChunkColdTierClear(void);
+
+ChunkColdTierStats ChunkColdTierGetStats(void);
+
+#endif // CHUNK_COLD_TIER_H
@@ -0,0 +1,118 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "chunkStorage.h"
+#include "chunkVoxels.h"
+#include "compression.h"
+#include "regionFile.h"
+
+#define CHUNK_PAYLOAD_VERSION 1
+
+size_t ChunkStorageEncode(const ChunkVoxels* voxels, unsigned char* out,
+                          const size_t capacity)
+{
+  if (capacity < CHUNK_PAYLOAD_HEADER_SIZE) return 0;
+
+  size_t rawSize;
+  const unsigned char* raw = ChunkVoxelsRawData(voxels, &rawSize);
+  out[0] = CHUNK_PAYLOAD_VERSION;
+  out[1] = voxels->bitsPerIndex;
+  out[2] = voxels->uniformType;
+  out[3] = 0;
+  out[4] = (unsigned char)(voxels->paletteSize & 0xff);
+  out[5] = (unsigned char)(voxels->paletteSize >> 8);
+  out[6] = 0;
+  out[7] = 0;
+  if (!raw) return CHUNK_PAYLOAD_HEADER_SIZE;
+
+  const size_t compressedSize =
+    LzCompress(raw, rawSize, out + CHUNK_PAYLOAD_HEADER_SIZE,
+               capacity - CHUNK_PAYLOAD_HEADER_SIZE);
+  if (!compressedSize) return 0;
+  return CHUNK_PAYLOAD_HEADER_SIZE + compressedSize;
+}
+
+bool ChunkStorageDecode(const unsigned char* payload, const size_t size,
+                        ChunkVoxels* voxels)
+{
+  if (size < CHUNK_PAYLOAD_HEADER_SIZE || payload[0] != CHUNK_PAYLOAD_VERSION)
+    return false;
+
+  const int bitsPerIndex = payload[1];
+  const int paletteSize = payload[4] | payload[5] << 8;
+  ChunkVoxelsFree(voxels);
+  if (bitsPerIndex == 0)
+  {
+    voxels->uniformType = payload[2];
+    if (size == CHUNK_PAYLOAD_HEADER_SIZE && ChunkVoxelsRawValidate(voxels))
+      return true;
+    ChunkVoxelsFree(voxels);
+    return false;
+  }
+
+  size_t rawSize;
+  unsigned char* raw =
+    ChunkVoxelsRawAllocate(voxels, bitsPerIndex, paletteSize, &rawSize);
+  if (!raw) return false;
+  if (!LzDecompress(payload + CHUNK_PAYLOAD_HEADER_SIZE,
+                    size - CHUNK_PAYLOAD_HEADER_SIZE, raw, rawSize) ||
+      !ChunkVoxelsRawValidate(voxels))
+  {
+    ChunkVoxelsFree(voxels);
+    return false;
+  }
+  return true;
+}
+
+bool ChunkStorageSave(const Chunk* chunk)
+{
+  if (!RegionStoreIsOpen()) return false;
+
+  unsigned char payload[CHUNK_PAYLOAD_MAX_SIZE];
+  const size_t size =
+    ChunkStorageEncode(&chunk->voxels, payload, sizeof(payload));
+  if (!size ||
+      !RegionStoreWrite(chunk->position.x, chunk->position.y,
+                        chunk->position.z, payload, size))
+  {
+    TraceLog(LOG_ERROR, "Failed to save chunk (%d, %d, %d)", chunk->position.x,
+             chunk->position.y, chunk->position.z);
+    return false;
+  }
+  return true;
+}
+
+static bool DecodeStoredPayload(const unsigned char* payload, const size_t size,
+                                void* user)
+{
+  return ChunkStorageDecode(payload, size, user);
+}
+
+bool ChunkStorageLoad(Chunk* chunk)
+{
+  return RegionStoreRead(chunk->position.x, chunk->position.y,
+                         chunk->position.z, DecodeStoredPayload,
+                         &chunk->voxels);
+}
@@ -0,0 +1,57 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Chunk voxels as stored payloads, a small header followed by the chunk's raw
+// palette allocation compressed with LZ. Uniform chunks are just the header.
+// Loading decompresses straight from the mapped region file into the chunk's
+// new allocation, so there's no copy on the way in.
+
+#ifndef CHUNK_STORAGE_H
+#define CHUNK_STORAGE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "chunkVoxels.h"
+#include "dataTypes.h"
+
+#define CHUNK_PAYLOAD_HEADER_SIZE 8
+// Enough for any chunk, LZ never grows data by more than a few percent
+#define CHUNK_PAYLOAD_MAX_SIZE (CHUNK_PAYLOAD_HEADER_SIZE + 2 * CHUNK_VOLUME)
+
+/* Encode voxels into out, returns the payload size or 0 if it didn't fit */
+size_t ChunkStorageEncode(const ChunkVoxels* voxels, unsigned char* out,
+                          size_t capacity);
+
+/* Replace voxels with a decoded payload, returns false if it's corrupt */
+bool ChunkStorageDecode(const unsigned char* payload, size_t size,
+                        ChunkVoxels* voxels);
+
+/* Write a chunk to the region files, false if they aren't open */
+bool ChunkStorageSave(const Chunk* chunk);
+
+/* Restore a chunk from the region files, false if it was never saved */
+bool ChunkStorageLoad(Chunk* chunk);
+
+#endif // CHUNK_STORAGE_H
@@ -0,0 +1,587 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Note: tinycthread pulls in windows.h on Windows, which clashes with raylib,
+// so this file must not include raylib.h (or anything that includes it).
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+  #define _POSIX_C_SOURCE 200809L // pread, pwrite
+#endif
+
+#include "regionFile.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tinycthread.h"
+
+#if defined(_WIN32)
+// windows.h is already included by tinycthread
+typedef HANDLE FileHandle;
+  #define INVALID_FILE INVALID_HANDLE_VALUE
+#else
+  #include <dirent.h>
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+typedef int FileHandle;
+  #define INVALID_FILE (-1)
+#endif
+
+#define REGION_MAGIC 0x47525856u // "VXRG"
+#define REGION_VERSION 1u
+#define REGION_CHUNK_COUNT (REGION_SIZE * REGION_SIZE * REGION_SIZE)
+#define REGION_HEADER_SIZE (8 + REGION_CHUNK_COUNT * sizeof(RegionEntry))
+#define REGION_SECTOR_SIZE 64
+#define REGION_DIRECTORY_SIZE 448
+#define REGION_PATH_SIZE 512 // Directory plus the longest region file name
+#define REGION_DEFAULT_OPEN 8 // Regions kept open until a radius is set
+
+// Where a chunk's payload is in the file, an offset of 0 means not stored
+typedef struct RegionEntry
+{
+  uint32_t offset;
+  uint32_t size;
+} RegionEntry;
+
+// A view of the file, kept alive by readers after the file has outgrown it
+typedef struct RegionMapping
+{
+  const unsigned char* base;
+  size_t size;
+  int readers;
+  bool retired;
+#if defined(_WIN32)
+  HANDLE handle;
+#endif
+} RegionMapping;
+
+typedef struct Region
+{
+  int regionX, regionY, regionZ;
+  FileHandle file; // INVALID_FILE until the first chunk is written
+  uint64_t fileSize;
+  RegionMapping* mapping;
+  struct Region* next;
+  RegionEntry table[REGION_CHUNK_COUNT];
+} Region;
+
+// Everything below is guarded by storeMutex, only payload reads run unlocked
+static mtx_t storeMutex;
+static bool storeOpen = false;
+static char storeDirectory[REGION_DIRECTORY_SIZE];
+static Region* regions = NULL; // Most recently used first
+static int regionCount = 0;
+static int maxOpenRegions = REGION_DEFAULT_OPEN;
+
+// Platform file access
+
+static bool FileOpen(const char* path, const bool create, FileHandle* file)
+{
+#if defined(_WIN32)
+  *file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE,
+                      FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                      create ? OPEN_ALWAYS : OPEN_EXISTING,
+                      FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+  *file = open(path, O_RDWR | (create ? O_CREAT : 0), 0644);
+#endif
+  return *file != INVALID_FILE;
+}
+
+// Flushing waits for the disk, so it's left to closing the whole store
+static void FileClose(const FileHandle file, const bool flush)
+{
+#if defined(_WIN32)
+  if (flush) FlushFileBuffers(file);
+  CloseHandle(file);
+#else
+  if (flush) fsync(file);
+  close(file);
+#endif
+}
+
+static bool FileSize(const FileHandle file, uint64_t* size)
+{
+#if defined(_WIN32)
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize)) return false;
+  *size = (uint64_t)fileSize.QuadPart;
+#else
+  struct stat info;
+  if (fstat(file, &info) != 0) return false;
+  *size = (uint64_t)info.st_size;
+#endif
+  return true;
+}
+
+static bool FileRead(const FileHandle file, const uint64_t offset, void* data,
+                     const size_t size)
+{
+#if defined(_WIN32)
+  OVERLAPPED overlapped = {0};
+  overlapped.Offset = (DWORD)offset;
+  overlapped.OffsetHigh = (DWORD)(offset >> 32);
+  DWORD read;
+  return ReadFile(file, data, (DWORD)size, &read, &overlapped) && read == size;
+#else
+  return pread(file, data, size, (off_t)offset) == (ssize_t)size;
+#endif
+}
+
+static bool FileWrite(const FileHandle file, const uint64_t offset,
+                      const void* data, const size_t size)
+{
+#if defined(_WIN32)
+  OVERLAPPED overlapped = {0};
+  overlapped.Offset = (DWORD)offset;
+  overlapped.OffsetHigh = (DWORD)(offset >> 32);
+  DWORD written;
+  return WriteFile(file, data, (DWORD)size, &written, &overlapped) &&
+         written == size;
+#else
+  return pwrite(file, data, size, (off_t)offset) == (ssize_t)size;
+#endif
+}
+
+static RegionMapping* MapFile(const FileHandle file, const uint64_t size)
+{
+  RegionMapping* mapping = calloc(1, sizeof(RegionMapping));
+  if (!mapping) return NULL;
+#if defined(_WIN32)
+  mapping->handle = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping->handle)
+  {
+    mapping->base = MapViewOfFile(mapping->handle, FILE_MAP_READ, 0, 0, 0);
+    if (!mapping->base) CloseHandle(mapping->handle);
+  }
+#else
+  void* base = mmap(NULL, size, PROT_READ, MAP_SHARED, file, 0);
+  mapping->base = base == MAP_FAILED ? NULL : base;
+#endif
+  if (!mapping->base)
+  {
+    free(mapping);
+    return NULL;
+  }
+  mapping->size = size;
+  return mapping;
+}
+
+static void UnmapFile(RegionMapping* mapping)
+{
+#if defined(_WIN32)
+  UnmapViewOfFile(mapping->base);
+  CloseHandle(mapping->handle);
+#else
+  munmap((void*)mapping->base, mapping->size);
+#endif
+  free(mapping);
+}
+
+static bool FileExists(const char* path)
+{
+#if defined(_WIN32)
+  return GetFileAttributesA(path) != INVALID_FILE_ATTRIBUTES;
+#else
+  struct stat info;
+  return stat(path, &info) == 0;
+#endif
+}
+
+static bool IsRegionFileName(const char* name)
+{
+  const size_t length = strlen(name);
+  return length > 6 && strncmp(name, "r.", 2) == 0 &&
+         strcmp(name + length - 4, ".vxr") == 0;
+}
+
+// Removes every region file in the directory, not just the open ones
+static void RemoveRegionFiles(const char* directory)
+{
+  char path[REGION_PATH_SIZE];
+#if defined(_WIN32)
+  snprintf(path, sizeof(path), "%s/r.*.vxr", directory);
+  WIN32_FIND_DATAA entry;
+  const HANDLE find = FindFirstFileA(path, &entry);
+  if (find == INVALID_HANDLE_VALUE) return;
+  do
+  {
+    if (!IsRegionFileName(entry.cFileName)) continue;
+    snprintf(path, sizeof(path), "%s/%s", directory, entry.cFileName);
+    remove(path);
+  } while (FindNextFileA(find, &entry));
+  FindClose(find);
+#else
+  DIR* dir = opendir(directory);
+  if (!dir) return;
+  const struct dirent* entry;
+  while ((entry = readdir(dir)))
+  {
+    if (!IsRegionFileName(entry->d_name)) continue;
+    snprintf(path, sizeof(path), "%s/%s", directory, entry->d_name);
+    remove(path);
+  }
+  closedir(dir);
+#endif
+}
+
+static void MakeDirectory(const char* path)
+{
+#if defined(_WIN32)
+  CreateDirectoryA(path, NULL);
+#else
+  mkdir(path, 0755);
+#endif
+}
+
+// Regions
+
+static int FloorDivide(const int value, const int divisor)
+{
+  return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+}
+
+static int SlotIndex(const int chunkX, const int chunkY, const int chunkZ)
+{
+  const int x = chunkX - FloorDivide(chunkX, REGION_SIZE) * REGION_SIZE;
+  const int y = chunkY - FloorDivide(chunkY, REGION_SIZE) * REGION_SIZE;
+  const int z = chunkZ - FloorDivide(chunkZ, REGION_SIZE) * REGION_SIZE;
+  return x + REGION_SIZE * (y + REGION_SIZE * z);
+}
+
+static void RegionPath(const int regionX, const int regionY, const int regionZ,
+                       char* path)
+{
+  snprintf(path, REGION_PATH_SIZE, "%s/r.%d.%d.%d.vxr", storeDirectory,
+           regionX, regionY, regionZ);
+}
+
+// Unmaps a view the region has moved on from once its last reader is done
+static void ReleaseMapping(RegionMapping* mapping)
+{
+  if (mapping->readers == 0 && mapping->retired) UnmapFile(mapping);
+}
+
+static void RetireMapping(Region* region)
+{
+  if (!region->mapping) return;
+  region->mapping->retired = true;
+  ReleaseMapping(region->mapping);
+  region->mapping = NULL;
+}
+
+// Reads the offset table of an existing file, anything unreadable starts over
+static void LoadRegionFile(Region* region)
+{
+  char path[REGION_PATH_SIZE];
+  RegionPath(region->regionX, region->regionY, region->regionZ, path);
+  if (!FileOpen(path, false, &region->file)) return;
+
+  uint32_t header[2];
+  if (!FileSize(region->file, &region->fileSize) ||
+      region->fileSize < REGION_HEADER_SIZE ||
+      !FileRead(region->file, 0, header, sizeof(header)) ||
+      header[0] != REGION_MAGIC || header[1] != REGION_VERSION ||
+      !FileRead(region->file, sizeof(header), region->table,
+                sizeof(region->table)))
+  {
+    fprintf(stderr, "RegionStore: Ignoring unreadable region file %s\n", path);
+    FileClose(region->file, false);
+    region->file = INVALID_FILE;
+    memset(region->table, 0, sizeof(region->table));
+    return;
+  }
+
+  // Entries pointing past the end of the file are treated as missing
+  for (int i = 0; i < REGION_CHUNK_COUNT; i++)
+  {
+    const RegionEntry entry = region->table[i];
+    if ((uint64_t)entry.offset + entry.size > region->fileSize)
+      region->table[i] = (RegionEntry){0};
+  }
+}
+
+static bool CreateRegionFile(Region* region)
+{
+  char path[REGION_PATH_SIZE];
+  RegionPath(region->regionX, region->regionY, region->regionZ, path);
+  if (!FileOpen(path, true, &region->file)) return false;
+
+  // A fresh header, any old unreadable file is overwritten
+  const uint32_t header[2] = {REGION_MAGIC, REGION_VERSION};
+  memset(region->table, 0, sizeof(region->table));
+  if (!FileWrite(region->file, 0, header, sizeof(header)) ||
+      !FileWrite(region->file, sizeof(header), region->table,
+                 sizeof(region->table)))
+  {
+    FileClose(region->file, false);
+    region->file = INVALID_FILE;
+    return false;
+  }
+  region->fileSize = REGION_HEADER_SIZE;
+  return true;
+}
+
+// Looks a region up and moves it to the front, so the back of the list is
+// always the least recently used one
+static Region* FindRegion(const int regionX, const int regionY,
+                          const int regionZ)
+{
+  for (Region** link = &regions; *link; link = &(*link)->next)
+  {
+    Region* region = *link;
+    if (region->regionX != regionX || region->regionY != regionY ||
+        region->regionZ != regionZ)
+      continue;
+    *link = region->next;
+    region->next = regions;
+    regions = region;
+    return region;
+  }
+  return NULL;
+}
+
+// Readers still in a payload keep its mapping alive until they're done, the
+// file and table can go straight away. Evicted regions aren't flushed, the
+// OS writes them back on its own and the lock isn't held for a disk flush
+static void CloseRegion(Region* region, const bool flush)
+{
+  RetireMapping(region);
+  if (region->file != INVALID_FILE) FileClose(region->file, flush);
+  free(region);
+}
+
+static void EvictRegions(void)
+{
+  while (regionCount > maxOpenRegions)
+  {
+    Region** link = &regions;
+    while ((*link)->next)
+      link = &(*link)->next;
+    Region* region = *link;
+    *link = NULL;
+    regionCount--;
+    CloseRegion(region, false);
+  }
+}
+
+// Without create, regions without a file on disk aren't opened at all and
+// NULL is returned, as there's nothing in them to read
+static Region* GetRegion(const int chunkX, const int chunkY, const int chunkZ,
+                         const bool create)
+{
+  const int regionX = FloorDivide(chunkX, REGION_SIZE);
+  const int regionY = FloorDivide(chunkY, REGION_SIZE);
+  const int regionZ = FloorDivide(chunkZ, REGION_SIZE);
+  Region* region = FindRegion(regionX, regionY, regionZ);
+  if (region) return region;
+
+  if (!create)
+  {
+    char path[REGION_PATH_SIZE];
+    RegionPath(regionX, regionY, regionZ, path);
+    if (!FileExists(path)) return NULL;
+  }
+
+  region = calloc(1, sizeof(Region));
+  if (!region) return NULL;
+  region->regionX = regionX;
+  region->regionY = regionY;
+  region->regionZ = regionZ;
+  region->file = INVALID_FILE;
+  LoadRegionFile(region);
+  region->next = regions;
+  regions = region;
+  regionCount++;
+  EvictRegions();
+  return region;
+}
+
+static void CloseRegions(void)
+{
+  while (regions)
+  {
+    Region* region = regions;
+    regions = region->next;
+    CloseRegion(region, true);
+  }
+  regionCount = 0;
+}
+
+// Store
+
+bool RegionStoreOpen(const char* directory)
+{
+  if (storeOpen) RegionStoreClose();
+  if (strlen(directory) >= REGION_DIRECTORY_SIZE) return false;
+  if (mtx_init(&storeMutex, mtx_plain) != thrd_success) return false;
+
+  strcpy(storeDirectory, directory);
+  MakeDirectory(storeDirectory);
+  storeOpen = true;
+  return true;
+}
+
+void RegionStoreClose(void)
+{
+  if (!storeOpen) return;
+  CloseRegions();
+  storeOpen = false;
+  mtx_destroy(&storeMutex);
+}
+
+void RegionStoreDelete(void)
+{
+  if (!storeOpen) return;
+  CloseRegions();
+  RemoveRegionFiles(storeDirectory);
+#if defined(_WIN32)
+  RemoveDirectoryA(storeDirectory);
+#else
+  rmdir(storeDirectory);
+#endif
+  storeOpen = false;
+  mtx_destroy(&storeMutex);
+}
+
+bool RegionStoreIsOpen(void) { return storeOpen; }
+
+void RegionStoreSetRadius(const int radius)
+{
+  // The chunks within radius of a center span at most this many regions
+  // along each axis, twice their count also keeps the ones just left behind
+  // open for the chunks unloaded there
+  const int perAxis = (2 * radius + REGION_SIZE - 1) / REGION_SIZE + 1;
+  const int maxOpen = 2 * perAxis * perAxis * perAxis;
+  if (maxOpen == maxOpenRegions) return;
+  if (!storeOpen)
+  {
+    maxOpenRegions = maxOpen;
+    return;
+  }
+  mtx_lock(&storeMutex);
+  maxOpenRegions = maxOpen;
+  EvictRegions();
+  mtx_unlock(&storeMutex);
+}
+
+int RegionStoreOpenRegionCount(void)
+{
+  if (!storeOpen) return 0;
+  mtx_lock(&storeMutex);
+  const int count = regionCount;
+  mtx_unlock(&storeMutex);
+  return count;
+}
+
+static uint64_t RoundToSector(const uint64_t size)
+{
+  return (size + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE *
+         REGION_SECTOR_SIZE;
+}
+
+bool RegionStoreWrite(const int chunkX, const int chunkY, const int chunkZ,
+                      const void* payload, const size_t size)
+{
+  if (!storeOpen || size == 0 || size > UINT32_MAX) return false;
+
+  mtx_lock(&storeMutex);
+  Region* region = GetRegion(chunkX, chunkY, chunkZ, true);
+  if (!region ||
+      (region->file == INVALID_FILE && !CreateRegionFile(region)))
+  {
+    mtx_unlock(&storeMutex);
+    return false;
+  }
+
+  // Rewrite in place if it still fits the old sectors, else append. Nothing
+  // can be reading the old payload: a chunk is written while loaded or when
+  // the cold tier evicts it, and it is never both in the cold tier and
+  // pending a load, since requests restore from the cold tier first
+  const int slot = SlotIndex(chunkX, chunkY, chunkZ);
+  RegionEntry entry = region->table[slot];
+  if (!entry.offset || RoundToSector(entry.size) < RoundToSector(size))
+    entry.offset = (uint32_t)RoundToSector(region->fileSize);
+  entry.size = (uint32_t)size;
+
+  const uint64_t end = (uint64_t)entry.offset + size;
+  bool written = end <= UINT32_MAX &&
+                 FileWrite(region->file, entry.offset, payload, size);
+  // The payload goes down before the entry pointing at it
+  written = written && FileWrite(region->file,
+                                 8 + (uint64_t)slot * sizeof(RegionEntry),
+                                 &entry, sizeof(entry));
+  if (written)
+  {
+    region->table[slot] = entry;
+    if (end > region->fileSize) region->fileSize = end;
+  }
+  mtx_unlock(&storeMutex);
+  return written;
+}
+
+bool RegionStoreRead(const int chunkX, const int chunkY, const int chunkZ,
+                     const RegionReadFunction read, void* user)
+{
+  if (!storeOpen) return false;
+
+  mtx_lock(&storeMutex);
+  Region* region = GetRegion(chunkX, chunkY, chunkZ, false);
+  const RegionEntry entry =
+    region ? region->table[SlotIndex(chunkX, chunkY, chunkZ)]
+           : (RegionEntry){0};
+  if (!entry.offset)
+  {
+    mtx_unlock(&storeMutex);
+    return false;
+  }
+
+  // The file grows as chunks are appended, map it again once it outgrew
+  // the view. Readers of the old view keep it alive until they're done
+  const uint64_t end = (uint64_t)entry.offset + entry.size;
+  if (!region->mapping || region->mapping->size < end)
+  {
+    RetireMapping(region);
+    region->mapping = MapFile(region->file, region->fileSize);
+  }
+  RegionMapping* mapping = region->mapping;
+  if (!mapping)
+  {
+    mtx_unlock(&storeMutex);
+    return false;
+  }
+  mapping->readers++;
+  mtx_unlock(&storeMutex);
+
+  const bool result = read(mapping->base + entry.offset, entry.size, user);
+
+  mtx_lock(&storeMutex);
+  mapping->readers--;
+  ReleaseMapping(mapping);
+  mtx_unlock(&storeMutex);
+  return result;
+}
@@ -0,0 +1,74 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Region files store the chunks of a REGION_SIZE^3 block of the world. Each
+// file starts with an offset table of every chunk slot, followed by the chunk
+// payloads, each padded to a sector so a rewrite that still fits its sectors
+// happens in place. Reads go through a memory mapping of the file, so a
+// payload is handed out straight from the page cache without being copied.
+//
+// Note: tinycthread and the OS file headers clash with raylib, so this file
+// must stay free of it. Payloads are opaque bytes here, see chunkStorage.
+
+#ifndef REGION_FILE_H
+#define REGION_FILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define REGION_SIZE 32 // Chunks along each axis of a region
+
+/* Called with a stored payload, valid only until it returns */
+typedef bool (*RegionReadFunction)(const unsigned char* payload, size_t size,
+                                   void* user);
+
+/* Start storing chunks in directory, creating it if needed */
+bool RegionStoreOpen(const char* directory);
+
+/* Flush and close every region file */
+void RegionStoreClose(void);
+
+/* Close the store and delete every region file in its directory */
+void RegionStoreDelete(void);
+
+bool RegionStoreIsOpen(void);
+
+/* Keep only as many regions open as streaming radius chunks around the
+ * player can reach, closing the least recently used ones past that */
+void RegionStoreSetRadius(int radius);
+
+/* Regions currently open, each holding its offset table and file */
+int RegionStoreOpenRegionCount(void);
+
+/* Store the payload of a chunk, replacing any earlier one. Thread safe */
+bool RegionStoreWrite(int chunkX, int chunkY, int chunkZ, const void* payload,
+                      size_t size);
+
+/* Hand the stored payload of a chunk to read, returning its result, or false
+ * if the chunk was never stored. Thread safe, reads run concurrently */
+bool RegionStoreRead(int chunkX, int chunkY, int chunkZ,
+                     RegionReadFunction read, void* user);
+
+#endif // REGION_FILE_H
@@ -0,0 +1,119 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "streamingOffsets.h"
+#include <stdlib.h>
+
+static Vector3I* offsets = NULL;
+static int offsetCount = 0;
+static int offsetDistance = -1;
+
+static int LengthSq(const Vector3I* offset)
+{
+  return offset->x * offset->x + offset->y * offset->y +
+         offset->z * offset->z;
+}
+
+// Nearest first, chunks level with the center before those above or below,
+// the rest by position so the order doesn't depend on qsort
+static int CompareOffsets(const void* a, const void* b)
+{
+  const Vector3I* offsetA = a;
+  const Vector3I* offsetB = b;
+  if (LengthSq(offsetA) != LengthSq(offsetB))
+    return LengthSq(offsetA) < LengthSq(offsetB) ? -1 : 1;
+  if (abs(offsetA->y) != abs(offsetB->y))
+    return abs(offsetA->y) < abs(offsetB->y) ? -1 : 1;
+  if (offsetA->y != offsetB->y) return offsetA->y < offsetB->y ? -1 : 1;
+  if (offsetA->x != offsetB->x) return offsetA->x < offsetB->x ? -1 : 1;
+  if (offsetA->z != offsetB->z) return offsetA->z < offsetB->z ? -1 : 1;
+  return 0;
+}
+
+const Vector3I* GetStreamingOffsets(const int distance, int* count)
+{
+  if (distance == offsetDistance)
+  {
+    *count = offsetCount;
+    return offsets;
+  }
+
+  FreeStreamingOffsets();
+  *count = 0;
+  if (distance < 0) return NULL;
+
+  const int side = 2 * distance + 1;
+  Vector3I* table = malloc((size_t)side * side * side * sizeof(Vector3I));
+  if (!table) return NULL;
+
+  int tableCount = 0;
+  for (int x = -distance; x <= distance; x++)
+  {
+    for (int y = -distance; y <= distance; y++)
+    {
+      for (int z = -distance; z <= distance; z++)
+      {
+        if (x * x + y * y + z * z <= distance * distance)
+          table[tableCount++] = (Vector3I){x, y, z};
+      }
+    }
+  }
+  qsort(table, tableCount, sizeof(Vector3I), CompareOffsets);
+
+  offsets = table;
+  offsetCount = tableCount;
+  offsetDistance = distance;
+  *count = offsetCount;
+  return offsets;
+}
+
+int GetStreamingShellStart(const int distance, const int innerDistance)
+{
+  int count;
+  const Vector3I* table = GetStreamingOffsets(distance, &count);
+  if (!table || innerDistance < 0) return 0;
+
+  // The table is sorted by length, so the shell starts where it gets longer
+  const int innerSq = innerDistance * innerDistance;
+  int low = 0;
+  int high = count;
+  while (low < high)
+  {
+    const int middle = low + (high - low) / 2;
+    if (LengthSq(&table[middle]) <= innerSq)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return low;
+}
+
+void FreeStreamingOffsets(void)
+{
+  free(offsets);
+  offsets = NULL;
+  offsetCount = 0;
+  offsetDistance = -1;
+}
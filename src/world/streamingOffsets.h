@@ -0,0 +1,46 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Chunk offsets within a draw distance, sorted nearest first, so streaming
+// can walk them in order and stop anywhere while the closest chunks are done.
+// Main thread only.
+
+#ifndef STREAMING_OFFSETS_H
+#define STREAMING_OFFSETS_H
+
+#include "dataTypes.h"
+
+/* Offsets of every chunk within distance of the center, nearest first. The
+ * table is kept until the distance changes. Returns NULL if it couldn't be
+ * built */
+const Vector3I* GetStreamingOffsets(int distance, int* count);
+
+/* Index of the first offset in the table for distance that's farther than
+ * innerDistance from the center, every offset before it is within */
+int GetStreamingShellStart(int distance, int innerDistance);
+
+void FreeStreamingOffsets(void);
+
+#endif // STREAMING_OFFSETS_H
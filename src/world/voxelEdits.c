@@ -0,0 +1,367 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include "voxelEdits.h"
+#include <math.h>
+#include <string.h>
+#include "chunkMap.h"
+#include "chunkMeshGeneration.h"
+#include "chunkVoxels.h"
+
+typedef enum VoxelEditKind
+{
+  EDIT_FILL_BOX,
+  EDIT_FILL_SPHERE,
+  EDIT_REPLACE,
+  EDIT_PASTE,
+} VoxelEditKind;
+
+typedef struct VoxelEdit
+{
+  VoxelEditKind kind;
+  Vector3I min; // Bounds of the edited voxels, both inclusive
+  Vector3I max;
+  VoxelType type; // Type written, for everything but pastes
+  VoxelType from; // Type replaced
+  Vector3 center; // Sphere
+  float radiusSquared;
+  const unsigned char* source; // Paste, laid out from min
+  Vector3I sourceSize;
+  bool skipAir;
+} VoxelEdit;
+
+static int MaxInt(const int a, const int b) { return a > b ? a : b; }
+static int MinInt(const int a, const int b) { return a < b ? a : b; }
+
+static bool IsValidType(const int type)
+{
+  return type >= 0 && type < VOXEL_TYPE_COUNT;
+}
+
+// True when the palette alone shows the edit can't change the chunk, so it
+// isn't unpacked at all
+static bool EditLeavesChunk(const VoxelEdit* edit, const ChunkVoxels* voxels)
+{
+  switch (edit->kind)
+  {
+    case EDIT_FILL_BOX:
+    case EDIT_FILL_SPHERE:
+      return ChunkVoxelsIsUniform(voxels) && voxels->uniformType == edit->type;
+    case EDIT_REPLACE: return ChunkVoxelsCount(voxels, edit->from) == 0;
+    case EDIT_PASTE: return false;
+  }
+  return false;
+}
+
+// Type the edit leaves at a world position holding current
+static VoxelType EditedType(const VoxelEdit* edit, const int x, const int y,
+                            const int z, const VoxelType current)
+{
+  switch (edit->kind)
+  {
+    case EDIT_FILL_BOX: return edit->type;
+    case EDIT_FILL_SPHERE:
+    {
+      const float dx = (float)x + 0.5f - edit->center.x;
+      const float dy = (float)y + 0.5f - edit->center.y;
+      const float dz = (float)z + 0.5f - edit->center.z;
+      const bool inside = dx * dx + dy * dy + dz * dz <= edit->radiusSquared;
+      return inside ? edit->type : current;
+    }
+    case EDIT_REPLACE: return current == edit->from ? edit->type : current;
+    case EDIT_PASTE:
+    {
+      const size_t index =
+        (size_t)(x - edit->min.x) +
+        (size_t)edit->sourceSize.x *
+          ((size_t)(y - edit->min.y) +
+           (size_t)edit->sourceSize.y * (size_t)(z - edit->min.z));
+      const VoxelType type = (VoxelType)edit->source[index];
+      return edit->skipAir && type == AIR ? current : type;
+    }
+  }
+  return current;
+}
+
+// Flags the neighbors whose shared border the edit changed, in their
+// coordinates that border is one past their own
+static void MarkEditedBordersDirty(const Chunk* chunk,
+                                   const unsigned int layers[3])
+{
+  for (int axis = 0; axis < 3; axis++)
+  {
+    for (int step = -1; step <= 1; step += 2)
+    {
+      const int border = step < 0 ? 0 : CHUNK_SIZE - 1;
+      if (!(layers[axis] & 1u << (border + 1))) continue;
+
+      Chunk* neighbor =
+        GetChunkFromMap(chunk->position.x + (axis == 0) * step,
+                        chunk->position.y + (axis == 1) * step,
+                        chunk->position.z + (axis == 2) * step);
+      if (!neighbor) continue;
+      unsigned int neighborLayers[3] = {0};
+      neighborLayers[axis] = 1u << (border - step * CHUNK_SIZE + 1);
+      MarkChunkLayersDirty(neighbor, neighborLayers);
+    }
+  }
+}
+
+// Applies the edit to the part of the box inside one chunk, returns the
+// number of voxels changed
+static int EditChunk(Chunk* chunk, const VoxelEdit* edit)
+{
+  const Vector3I origin = {chunk->position.x * CHUNK_SIZE,
+                           chunk->position.y * CHUNK_SIZE,
+                           chunk->position.z * CHUNK_SIZE};
+  const int minX = MaxInt(edit->min.x - origin.x, 0);
+  const int minY = MaxInt(edit->min.y - origin.y, 0);
+  const int minZ = MaxInt(edit->min.z - origin.z, 0);
+  const int maxX = MinInt(edit->max.x - origin.x, CHUNK_SIZE - 1);
+  const int maxY = MinInt(edit->max.y - origin.y, CHUNK_SIZE - 1);
+  const int maxZ = MinInt(edit->max.z - origin.z, CHUNK_SIZE - 1);
+  if (EditLeavesChunk(edit, &chunk->voxels)) return 0;
+
+  unsigned char types[CHUNK_VOLUME];
+  for (int z = 0; z < CHUNK_SIZE; z++)
+    for (int y = 0; y < CHUNK_SIZE; y++)
+      ChunkVoxelsUnpackRow(&chunk->voxels, y, z, &types[VOXEL_INDEX(0, y, z)]);
+
+  int changed = 0;
+  unsigned int layers[3] = {0};
+  for (int z = minZ; z <= maxZ; z++)
+  {
+    for (int y = minY; y <= maxY; y++)
+    {
+      unsigned char* row = &types[VOXEL_INDEX(0, y, z)];
+      for (int x = minX; x <= maxX; x++)
+      {
+        const VoxelType type =
+          EditedType(edit, origin.x + x, origin.y + y, origin.z + z,
+                     (VoxelType)row[x]);
+        if (type == row[x]) continue;
+        row[x] = (unsigned char)type;
+        changed++;
+        layers[0] |= 1u << (x + 1);
+        layers[1] |= 1u << (y + 1);
+        layers[2] |= 1u << (z + 1);
+      }
+    }
+  }
+  // Nothing to repack or remesh
+  if (!changed) return 0;
+
+  // Packed aside so a failed allocation leaves the chunk as it was
+  ChunkVoxels packed = {0};
+  if (!ChunkVoxelsPack(&packed, types))
+  {
+    TraceLog(LOG_ERROR, "Failed to allocate voxel data for chunk");
+    return 0;
+  }
+  ChunkVoxelsFree(&chunk->voxels);
+  chunk->voxels = packed;
+  chunk->unsaved = true;
+
+  MarkChunkLayersDirty(chunk, layers);
+  MarkEditedBordersDirty(chunk, layers);
+  return changed;
+}
+
+static int ApplyVoxelEdit(const VoxelEdit* edit)
+{
+  if (!loadedChunks) return 0;
+
+  const Vector3I minChunk = {WorldToChunkCoord(edit->min.x),
+                             WorldToChunkCoord(edit->min.y),
+                             WorldToChunkCoord(edit->min.z)};
+  const Vector3I maxChunk = {WorldToChunkCoord(edit->max.x),
+                             WorldToChunkCoord(edit->max.y),
+                             WorldToChunkCoord(edit->max.z)};
+  const long long spannedChunks =
+    (long long)(maxChunk.x - minChunk.x + 1) *
+    (long long)(maxChunk.y - minChunk.y + 1) *
+    (long long)(maxChunk.z - minChunk.z + 1);
+
+  int changed = 0;
+  // Boxes larger than the loaded world look at the loaded chunks instead of
+  // every chunk position they span
+  if (spannedChunks > (long long)ChunkHashMapSize(loadedChunks))
+  {
+    ChunkHashMapIterator it = ChunkHashMapIteratorCreate(loadedChunks);
+    Chunk* chunk;
+    while (ChunkHashMapIteratorNext(&it, NULL, &chunk))
+    {
+      const Vector3I pos = chunk->position;
+      if (pos.x < minChunk.x || pos.x > maxChunk.x || pos.y < minChunk.y ||
+          pos.y > maxChunk.y || pos.z < minChunk.z || pos.z > maxChunk.z)
+        continue;
+      changed += EditChunk(chunk, edit);
+    }
+    return changed;
+  }
+
+  for (int z = minChunk.z; z <= maxChunk.z; z++)
+  {
+    for (int y = minChunk.y; y <= maxChunk.y; y++)
+    {
+      for (int x = minChunk.x; x <= maxChunk.x; x++)
+      {
+        Chunk* chunk = GetChunkFromMap(x, y, z);
+        if (chunk) changed += EditChunk(chunk, edit);
+      }
+    }
+  }
+  return changed;
+}
+
+// Orders the corners of a box so min holds the smaller coordinates
+static void SortBox(Vector3I* min, Vector3I* max)
+{
+  const Vector3I a = *min;
+  const Vector3I b = *max;
+  *min = (Vector3I){MinInt(a.x, b.x), MinInt(a.y, b.y), MinInt(a.z, b.z)};
+  *max = (Vector3I){MaxInt(a.x, b.x), MaxInt(a.y, b.y), MaxInt(a.z, b.z)};
+}
+
+int FillVoxelBox(Vector3I min, Vector3I max, const VoxelType type)
+{
+  if (!IsValidType(type)) return 0;
+  SortBox(&min, &max);
+  const VoxelEdit edit = {.kind = EDIT_FILL_BOX,
+                          .min = min,
+                          .max = max,
+                          .type = type};
+  return ApplyVoxelEdit(&edit);
+}
+
+int FillVoxelSphere(const Vector3 center, const float radius,
+                    const VoxelType type)
+{
+  if (!(radius >= 0.0f) || !IsValidType(type)) return 0;
+  const VoxelEdit edit = {
+    .kind = EDIT_FILL_SPHERE,
+    .min = {(int)floorf(center.x - radius), (int)floorf(center.y - radius),
+            (int)floorf(center.z - radius)},
+    .max = {(int)floorf(center.x + radius), (int)floorf(center.y + radius),
+            (int)floorf(center.z + radius)},
+    .type = type,
+    .center = center,
+    .radiusSquared = radius * radius};
+  return ApplyVoxelEdit(&edit);
+}
+
+int ReplaceVoxels(Vector3I min, Vector3I max, const VoxelType from,
+                  const VoxelType to)
+{
+  if (from == to || !IsValidType(from) || !IsValidType(to)) return 0;
+  SortBox(&min, &max);
+  const VoxelEdit edit = {.kind = EDIT_REPLACE,
+                          .min = min,
+                          .max = max,
+                          .type = to,
+                          .from = from};
+  return ApplyVoxelEdit(&edit);
+}
+
+int PasteVoxels(const Vector3I origin, const Vector3I size,
+                const unsigned char* types, const bool skipAir)
+{
+  if (!types || size.x <= 0 || size.y <= 0 || size.z <= 0) return 0;
+
+  // Checked up front so a bad buffer never leaves half a paste behind
+  const size_t count = (size_t)size.x * (size_t)size.y * (size_t)size.z;
+  for (size_t i = 0; i < count; i++)
+  {
+    if (IsValidType(types[i])) continue;
+    TraceLog(LOG_ERROR, "Refusing to paste invalid voxel type %d", types[i]);
+    return 0;
+  }
+
+  const VoxelEdit edit = {
+    .kind = EDIT_PASTE,
+    .min = origin,
+    .max = {origin.x + size.x - 1, origin.y + size.y - 1,
+            origin.z + size.z - 1},
+    .source = types,
+    .sourceSize = size,
+    .skipAir = skipAir};
+  return ApplyVoxelEdit(&edit);
+}
+
+size_t GetVoxelRegion(const Vector3I min, const Vector3I max,
+                      unsigned char* out)
+{
+  if (!out || min.x > max.x || min.y > max.y || min.z > max.z) return 0;
+  const size_t sizeX = (size_t)max.x - (size_t)min.x + 1;
+  const size_t sizeY = (size_t)max.y - (size_t)min.y + 1;
+  const size_t sizeZ = (size_t)max.z - (size_t)min.z + 1;
+
+  // Each chunk is looked up once and copied a row at a time
+  unsigned char row[CHUNK_SIZE];
+  for (int chunkZ = WorldToChunkCoord(min.z);
+       chunkZ <= WorldToChunkCoord(max.z); chunkZ++)
+  {
+    for (int chunkY = WorldToChunkCoord(min.y);
+         chunkY <= WorldToChunkCoord(max.y); chunkY++)
+    {
+      for (int chunkX = WorldToChunkCoord(min.x);
+           chunkX <= WorldToChunkCoord(max.x); chunkX++)
+      {
+        const Chunk* chunk =
+          loadedChunks ? GetChunkFromMap(chunkX, chunkY, chunkZ) : NULL;
+        const Vector3I origin = {chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE,
+                                 chunkZ * CHUNK_SIZE};
+        const int minX = MaxInt(min.x - origin.x, 0);
+        const int minY = MaxInt(min.y - origin.y, 0);
+        const int minZ = MaxInt(min.z - origin.z, 0);
+        const int maxX = MinInt(max.x - origin.x, CHUNK_SIZE - 1);
+        const int maxY = MinInt(max.y - origin.y, CHUNK_SIZE - 1);
+        const int maxZ = MinInt(max.z - origin.z, CHUNK_SIZE - 1);
+        const size_t rowLength = (size_t)(maxX - minX + 1);
+
+        for (int z = minZ; z <= maxZ; z++)
+        {
+          for (int y = minY; y <= maxY; y++)
+          {
+            unsigned char* dst =
+              &out[(size_t)(origin.x + minX - min.x) +
+                   sizeX * ((size_t)(origin.y + y - min.y) +
+                            sizeY * (size_t)(origin.z + z - min.z))];
+            if (!chunk)
+              memset(dst, AIR, rowLength);
+            else if (rowLength == CHUNK_SIZE)
+              ChunkVoxelsUnpackRow(&chunk->voxels, y, z, dst);
+            else
+            {
+              ChunkVoxelsUnpackRow(&chunk->voxels, y, z, row);
+              memcpy(dst, &row[minX], rowLength);
+            }
+          }
+        }
+      }
+    }
+  }
+  return sizeX * sizeY * sizeZ;
+}
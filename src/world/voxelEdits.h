@@ -0,0 +1,65 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Reads and edits of many voxels at once. Each loaded chunk an edit overlaps
+// is unpacked, changed and packed again in one go, and flagged for a single
+// remesh of just the layers that changed, plus the borders of its neighbors
+// when the edit reaches them. Chunks the edit leaves as they were aren't
+// repacked or remeshed, and chunks that aren't loaded are skipped by edits and
+// read as AIR.
+//
+// Positions are world voxel coordinates, boxes include both corners. Every
+// edit returns the number of voxels it changed, 0 when given a type that isn't
+// a valid VoxelType. Main thread only.
+
+#ifndef VOXEL_EDITS_H
+#define VOXEL_EDITS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "dataTypes.h"
+
+/* Set every voxel in the box to type */
+int FillVoxelBox(Vector3I min, Vector3I max, VoxelType type);
+
+/* Set every voxel whose center lies within radius of center to type */
+int FillVoxelSphere(Vector3 center, float radius, VoxelType type);
+
+/* Turn the voxels of type from in the box into type to */
+int ReplaceVoxels(Vector3I min, Vector3I max, VoxelType from, VoxelType to);
+
+/* Copy size.x * size.y * size.z types, x fastest then y then z, into the
+ * world starting at origin. AIR in types leaves the world as is when skipAir
+ * is set, so only the solid part of a structure is pasted. Nothing is pasted
+ * if any of the types isn't a valid VoxelType */
+int PasteVoxels(Vector3I origin, Vector3I size, const unsigned char* types,
+                bool skipAir);
+
+/* Copy the types of every voxel in the box into out, laid out like the types
+ * of PasteVoxels, so a region read can be pasted back elsewhere. Returns the
+ * number of voxels written, 0 if min lies past max on any axis */
+size_t GetVoxelRegion(Vector3I min, Vector3I max, unsigned char* out);
+
+#endif // VOXEL_EDITS_H
@@ -25,19 +25,48 @@
 
 #include "world.h"
 #include <stdlib.h>
+#include "caveCulling.h"
+#include "chunkColdTier.h"
+#include "chunkCulling.h"
 #include "chunkMap.h"
 #include "chunkMeshGeneration.h"
+#include "chunkRenderer.h"
+#include "chunkStorage.h"
+#include "chunkVoxels.h"
 #include "darray.h"
+#include "drawRegions.h"
 #include "gui.h"
+#include "heightmapCache.h"
+#include "jobSystem.h"
 #include "player.h"
+#include "regionFile.h"
 #include "settings.h"
+#include "streamingOffsets.h"
+#include "timer.h"
 #include "worldGeneration.h"
 
 // Function prototypes
 static void UpdateNeighboringChunkMeshes(int chunkX, int chunkY, int chunkZ);
-static void CheckAndFreeEmptyChunk(Chunk* chunk);
 
-Map* loadedChunks = NULL;
+ChunkHashMap* loadedChunks = NULL;
+
+// Chunks whose voxel data is still being generated by a worker thread, they
+// only join loadedChunks once the main thread has picked them back up
+static ChunkHashMap* pendingChunks = NULL;
+
+// Last area LoadChunksInRenderDistance streamed in, only moving to another
+// chunk or changing the distance makes it look at the world again
+static bool streamingActive = false;
+static Vector3I streamingCenter = {0};
+static int streamingDistance = 0;
+
+// How far the nearest-first walk over the streaming offsets has come, work
+// past it carries over to later frames
+static int streamingCursor = 0;
+
+// What UpdateChunkLods last measured levels of detail from
+static Vector3I lastLodCenter = {0};
+static int lastLodDistance = 0;
 
 // Helpers
 
@@ -57,6 +86,31 @@ static void WorldToLocalCoords(const Vector3 pos, int* localX, int* localY,
   *localZ = ((int)floorf(pos.z) % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
 }
 
+// Passes an edit of a chunk's border on to the neighbor across it, in the
+// neighbor's coordinates that's one past its own border
+static void MarkBorderNeighborsDirty(const Chunk* chunk, const int localX,
+                                     const int localY, const int localZ)
+{
+  const int local[3] = {localX, localY, localZ};
+  for (int axis = 0; axis < 3; axis++)
+  {
+    int step = 0;
+    if (local[axis] == 0) step = -1;
+    if (local[axis] == CHUNK_SIZE - 1) step = 1;
+    if (step == 0) continue;
+
+    int neighborLocal[3] = {localX, localY, localZ};
+    neighborLocal[axis] -= step * CHUNK_SIZE;
+    Chunk* neighbor =
+      GetChunkFromMap(chunk->position.x + (axis == 0) * step,
+                      chunk->position.y + (axis == 1) * step,
+                      chunk->position.z + (axis == 2) * step);
+    if (neighbor)
+      MarkChunkVoxelDirty(neighbor, neighborLocal[0], neighborLocal[1],
+                          neighborLocal[2]);
+  }
+}
+
 // Function to place a block
 void PlaceVoxel(const Vector3 position, const VoxelType type)
 {
@@ -71,100 +125,226 @@ void PlaceVoxel(const Vector3 position, const VoxelType type)
 
   int localX, localY, localZ;
   WorldToLocalCoords(position, &localX, &localY, &localZ);
-  if (!chunk->voxels)
+  if (!ChunkVoxelsSet(&chunk->voxels, localX, localY, localZ, type))
   {
-    chunk->voxels = calloc(CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE, sizeof(Voxel));
-    if (!chunk->voxels)
-    {
-      TraceLog(LOG_ERROR, "Failed to allocate voxel data for chunk");
-      return;
-    }
+    TraceLog(LOG_ERROR, "Failed to allocate voxel data for chunk");
+    return;
   }
-  chunk->voxels[VOXEL_INDEX(localX, localY, localZ)] = (Voxel){type};
-  chunk->needsMeshing = true;
-  // Mark neighbors as needing re-mesh in case their visible faces change
-  UpdateNeighboringChunkMeshes(chunkX, chunkY, chunkZ);
+  MarkChunkVoxelDirty(chunk, localX, localY, localZ);
+  chunk->unsaved = true;
+  // Neighbors only see the edit when it is on the border they share
+  MarkBorderNeighborsDirty(chunk, localX, localY, localZ);
 }
 
-// Function to break a voxel
-void BreakVoxel(const Vector3 position)
-{
-  PlaceVoxel(position, AIR);
+// Function to break a voxel, chunks left with only AIR free their voxels
+void BreakVoxel(const Vector3 position) { PlaceVoxel(position, AIR); }
 
-  int chunkX, chunkY, chunkZ;
-  WorldToChunkCoords(position, &chunkX, &chunkY, &chunkZ);
-  Chunk* chunk = GetChunkFromMap(chunkX, chunkY, chunkZ);
-  if (chunk) CheckAndFreeEmptyChunk(chunk);
+Voxel GetVoxel(const Vector3 position)
+{
+  return GetVoxelAt((Vector3I){(int)floorf(position.x), (int)floorf(position.y),
+                               (int)floorf(position.z)});
 }
 
-Voxel GetVoxel(const Vector3 position)
+Voxel GetVoxelAt(const Vector3I position)
 {
-  int chunkX, chunkY, chunkZ;
-  WorldToChunkCoords(position, &chunkX, &chunkY, &chunkZ);
+  const int chunkX = WorldToChunkCoord(position.x);
+  const int chunkY = WorldToChunkCoord(position.y);
+  const int chunkZ = WorldToChunkCoord(position.z);
   const Chunk* chunk = GetChunkFromMap(chunkX, chunkY, chunkZ);
-  if (!chunk || !chunk->voxels) return (Voxel){AIR};
-  int localX, localY, localZ;
-  WorldToLocalCoords(position, &localX, &localY, &localZ);
-  return chunk->voxels[VOXEL_INDEX(localX, localY, localZ)];
+  if (!chunk) return (Voxel){AIR};
+  return (Voxel){ChunkVoxelsGet(&chunk->voxels,
+                                position.x - chunkX * CHUNK_SIZE,
+                                position.y - chunkY * CHUNK_SIZE,
+                                position.z - chunkZ * CHUNK_SIZE)};
+}
+
+// Flags every loaded chunk to be meshed again, e.g. after a mesher change
+void RemeshWorld()
+{
+  ChunkHashMapIterator it = ChunkHashMapIteratorCreate(loadedChunks);
+  Chunk* chunk;
+  while (ChunkHashMapIteratorNext(&it, NULL, &chunk))
+    MarkChunkMeshDirty(chunk);
 }
 
-// Completely destroys the currently loaded chunks
-void DestroyWorld() { ClearChunkMap(); }
+VoxelMemoryStats GetVoxelMemoryStats()
+{
+  VoxelMemoryStats stats = {0};
+  ChunkHashMapIterator it = ChunkHashMapIteratorCreate(loadedChunks);
+  Chunk* chunk;
+  while (ChunkHashMapIteratorNext(&it, NULL, &chunk))
+  {
+    const size_t bytes = ChunkVoxelsMemoryUsage(&chunk->voxels);
+    stats.chunkCount++;
+    stats.storedChunkCount += bytes > 0;
+    stats.solidChunkCount += ChunkVoxelsIsSolid(&chunk->voxels);
+    stats.bytes += bytes;
+  }
+  return stats;
+}
 
-Chunk* CreateChunk(const int chunkX, const int chunkY, const int chunkZ)
+// Unloads every chunk, saving them to the region files if those are open
+void DestroyWorld()
 {
+  // Let in-flight generation land first so no chunk is left behind
+  JobSystemWaitIdle();
+  JobSystemProcessCompleted(0);
+  ClearReadyChunkMeshes();
+  ClearDirtyChunkMeshes();
+  ClearChunkMap();
+  ChunkColdTierClear();
+  HeightmapCacheClear();
+  FreeStreamingOffsets();
+  streamingActive = false;
+  streamingCursor = 0;
+}
+
+static bool IsChunkInStreamingRange(const Vector3I position)
+{
+  const int distanceX = position.x - streamingCenter.x;
+  const int distanceY = position.y - streamingCenter.y;
+  const int distanceZ = position.z - streamingCenter.z;
+  return distanceX * distanceX + distanceY * distanceY +
+           distanceZ * distanceZ <=
+         streamingDistance * streamingDistance;
+}
+
+static bool IsChunkPending(const int chunkX, const int chunkY, const int chunkZ)
+{
+  const ChunkKey key = {chunkX, chunkY, chunkZ};
+  return ChunkHashMapGet(pendingChunks, key) != NULL;
+}
+
+// Worker side of chunk creation, only touches the chunk it was given
+static void GenerateChunkJob(void* data)
+{
+  Chunk* chunk = data;
+  // Chunks saved before come back as they were left, edits and all
+  if (ChunkStorageLoad(chunk)) return;
+  GenerateChunk(chunk);
+  chunk->unsaved = true;
+}
+
+// Main thread side of chunk creation
+static void CompleteChunkJob(void* data)
+{
+  Chunk* chunk = data;
+  const ChunkKey key = {chunk->position.x, chunk->position.y,
+                        chunk->position.z};
+  ChunkHashMapRemove(pendingChunks, key);
+  HeightmapCacheRelease(chunk->column);
+  chunk->column = NULL;
+
+  // The player may have moved away while the chunk was being generated
+  if (!IsChunkInStreamingRange(chunk->position))
+  {
+    ChunkPoolRelease(chunk);
+    return;
+  }
+
+  AddChunkToMap(key.chunkX, key.chunkY, key.chunkZ, chunk);
+  MarkChunkMeshDirty(chunk);
+  UpdateNeighboringChunkMeshes(key.chunkX, key.chunkY, key.chunkZ);
+}
+
+// Queues a chunk for generation on the worker threads, returns false if it
+// couldn't so it can be tried again later
+static bool RequestChunk(const int chunkX, const int chunkY, const int chunkZ)
+{
+  if (!pendingChunks)
+  {
+    pendingChunks = ChunkHashMapCreate(CHUNK_HASH_MAP_INITIAL_CAPACITY);
+    if (!pendingChunks)
+    {
+      TraceLog(LOG_ERROR, "Failed to create pending chunk map");
+      return false;
+    }
+  }
+
   Chunk* chunk = ChunkPoolAcquire();
   if (!chunk)
   {
     TraceLog(LOG_ERROR, "ChunkPoolAcquire failed");
-    return NULL;
+    return false;
   }
   chunk->position.x = chunkX;
   chunk->position.y = chunkY;
   chunk->position.z = chunkZ;
-  chunk->needsMeshing = true;
-  chunk->voxels = NULL;
+  chunk->needsMeshing = false;
+  chunk->unsaved = false;
+  chunk->voxels = (ChunkVoxels){0};
 
-  GenerateChunk(chunk);
-  UpdateNeighboringChunkMeshes(chunkX, chunkY, chunkZ);
+  // Chunks unloaded a moment ago come straight back from the cold tier
+  if (ChunkColdTierRestore(chunk))
+  {
+    AddChunkToMap(chunkX, chunkY, chunkZ, chunk);
+    MarkChunkMeshDirty(chunk);
+    UpdateNeighboringChunkMeshes(chunkX, chunkY, chunkZ);
+    return true;
+  }
+
+  // Without a cached column the chunk just generates its own heightmap
+  chunk->column = HeightmapCacheAcquire(chunkX, chunkZ);
 
-  return chunk;
+  if (!JobSystemSubmit(GenerateChunkJob, CompleteChunkJob, chunk))
+  {
+    TraceLog(LOG_ERROR, "Failed to queue generation of chunk (%d, %d, %d)",
+             chunkX, chunkY, chunkZ);
+    HeightmapCacheRelease(chunk->column);
+    ChunkPoolRelease(chunk);
+    return false;
+  }
+
+  const ChunkKey key = {chunkX, chunkY, chunkZ};
+  ChunkHashMapPut(pendingChunks, key, chunk);
+  return true;
 }
 
 void LoadChunksInRenderDistance(void)
 {
   const Vector3I playerChunk = GetPlayerChunk();
-  const int drawDistance = GetDrawDistance();
-  const int drawDistanceSq = drawDistance * drawDistance;
+  UpdateChunkLods(playerChunk, GetLodDistance());
+  LoadChunksAround(playerChunk, GetDrawDistance(), GetStreamingBudget());
+}
+
+// Requests missing chunks nearest first until the budget runs out, at least
+// one chunk is looked at per call so streaming always moves forward
+static void RequestChunksNearestFirst(const Vector3I playerChunk,
+                                      const int drawDistance,
+                                      const float budgetMs)
+{
+  int offsetCount;
+  const Vector3I* offsets = GetStreamingOffsets(drawDistance, &offsetCount);
+  if (!offsets)
+  {
+    TraceLog(LOG_ERROR, "Failed to build streaming offsets");
+    return;
+  }
 
-  // Create any missing chunks in render radius
-  for (int chunkX = playerChunk.x - drawDistance;
-       chunkX <= playerChunk.x + drawDistance; chunkX++)
+  const uint64_t start = TimerNowNanoseconds();
+  const uint64_t budget = (uint64_t)(budgetMs * 1000000.0f);
+  while (streamingCursor < offsetCount)
   {
-    for (int chunkY = playerChunk.y - drawDistance;
-         chunkY <= playerChunk.y + drawDistance; chunkY++)
+    const int chunkX = playerChunk.x + offsets[streamingCursor].x;
+    const int chunkY = playerChunk.y + offsets[streamingCursor].y;
+    const int chunkZ = playerChunk.z + offsets[streamingCursor].z;
+    if (!GetChunkFromMap(chunkX, chunkY, chunkZ) &&
+        !IsChunkPending(chunkX, chunkY, chunkZ) &&
+        !RequestChunk(chunkX, chunkY, chunkZ))
     {
-      for (int chunkZ = playerChunk.z - drawDistance;
-           chunkZ <= playerChunk.z + drawDistance; chunkZ++)
-      {
-        const int distanceX = chunkX - playerChunk.x;
-        const int distanceY = chunkY - playerChunk.y;
-        const int distanceZ = chunkZ - playerChunk.z;
-        const int distanceSq =
-          distanceX * distanceX + distanceY * distanceY + distanceZ * distanceZ;
-        if (distanceSq <= drawDistanceSq)
-        {
-          if (!GetChunkFromMap(chunkX, chunkY, chunkZ))
-          {
-            Chunk* newChunk = CreateChunk(chunkX, chunkY, chunkZ);
-            if (newChunk) AddChunkToMap(chunkX, chunkY, chunkZ, newChunk);
-          }
-        }
-      }
+      break;
     }
+    streamingCursor++;
+
+    if (budgetMs > 0.0f && TimerNowNanoseconds() - start >= budget) break;
   }
+}
+
+// Drops every loaded chunk out of range, used when the draw distance changes
+static void UnloadChunksOutOfRange(void)
+{
+  if (!loadedChunks) return;
 
-  // Determine which chunks should be removed or re-meshed
   DArray* chunksToRemove = DArrayCreate(sizeof(ChunkKey));
   if (!chunksToRemove)
   {
@@ -172,21 +352,15 @@ void LoadChunksInRenderDistance(void)
     return;
   }
 
-  MapIterator it = MapIteratorCreate(loadedChunks);
+  ChunkHashMapIterator it = ChunkHashMapIteratorCreate(loadedChunks);
   ChunkKey key;
   Chunk* chunk;
-  while (MapIteratorNext(&it, &key, &chunk))
+  while (ChunkHashMapIteratorNext(&it, &key, &chunk))
   {
-    const int distanceX = key.chunkX - playerChunk.x;
-    const int distanceY = key.chunkY - playerChunk.y;
-    const int distanceZ = key.chunkZ - playerChunk.z;
-    const int distanceSq =
-      distanceX * distanceX + distanceY * distanceY + distanceZ * distanceZ;
-    if (distanceSq > drawDistanceSq) { DArrayPush(chunksToRemove, &key); }
-    else if (chunk->needsMeshing) { GenerateChunkMesh(chunk); }
+    if (!IsChunkInStreamingRange(chunk->position))
+      DArrayPush(chunksToRemove, &key);
   }
 
-  // Remove out-of-range chunks
   for (size_t i = 0; i < DArraySize(chunksToRemove); i++)
   {
     ChunkKey removeKey;
@@ -196,32 +370,152 @@ void LoadChunksInRenderDistance(void)
   DArrayFree(chunksToRemove);
 }
 
-// Draws all the currently loaded chunks
+// Length of a step between chunks, rounded up to whole chunks
+static float StepLength(const Vector3I from, const Vector3I to)
+{
+  const float stepX = (float)to.x - (float)from.x;
+  const float stepY = (float)to.y - (float)from.y;
+  const float stepZ = (float)to.z - (float)from.z;
+  return ceilf(sqrtf(stepX * stepX + stepY * stepY + stepZ * stepZ));
+}
+
+// Where the offset table stops being in range of both centers, a step of n
+// chunks can only affect offsets farther than drawDistance - n out
+static int StreamingShellStart(const Vector3I from, const Vector3I to,
+                               const int drawDistance)
+{
+  const float step = StepLength(from, to);
+  if (step >= (float)drawDistance) return 0;
+  return GetStreamingShellStart(drawDistance, drawDistance - (int)step);
+}
+
+// Drops the chunks the old center had in range and the new one doesn't, all
+// of them are in the shell of the old sphere
+static void UnloadLeavingShell(const Vector3I oldCenter, const int shellStart)
+{
+  if (!loadedChunks) return;
+
+  int offsetCount;
+  const Vector3I* offsets =
+    GetStreamingOffsets(streamingDistance, &offsetCount);
+  for (int i = shellStart; i < offsetCount; i++)
+  {
+    const Vector3I position = {oldCenter.x + offsets[i].x,
+                               oldCenter.y + offsets[i].y,
+                               oldCenter.z + offsets[i].z};
+    if (!IsChunkInStreamingRange(position))
+      RemoveChunkFromMap(position.x, position.y, position.z);
+  }
+}
+
+// Streams in the chunks within drawDistance of playerChunk, nearest first and
+// for at most budgetMs a call (0 for no limit), and drops the rest. Only
+// crossing into another chunk or changing the distance makes it look at the
+// world again, and a step only touches the shells entering and leaving range
+void LoadChunksAround(const Vector3I playerChunk, const int drawDistance,
+                      const float budgetMs)
+{
+  const bool moved = playerChunk.x != streamingCenter.x ||
+                     playerChunk.y != streamingCenter.y ||
+                     playerChunk.z != streamingCenter.z;
+  if (!streamingActive || drawDistance != streamingDistance)
+  {
+    streamingActive = true;
+    streamingCenter = playerChunk;
+    streamingDistance = drawDistance;
+    streamingCursor = 0;
+    UnloadChunksOutOfRange();
+  }
+  else if (moved)
+  {
+    const Vector3I oldCenter = streamingCenter;
+    const int shellStart =
+      StreamingShellStart(oldCenter, playerChunk, drawDistance);
+    streamingCenter = playerChunk;
+    UnloadLeavingShell(oldCenter, shellStart);
+
+    // Offsets before the shell were in range of the old center too, so once
+    // it was fully streamed in only the shell is left to look at
+    int offsetCount;
+    GetStreamingOffsets(drawDistance, &offsetCount);
+    streamingCursor = streamingCursor >= offsetCount ? shellStart : 0;
+  }
+  HeightmapCacheSetRadius(playerChunk.x, playerChunk.z, drawDistance);
+  RegionStoreSetRadius(drawDistance);
+
+  RequestChunksNearestFirst(playerChunk, drawDistance, budgetMs);
+  ScheduleDirtyChunkMeshes(GetMeshingMode());
+}
+
+// Uploads a limited amount of finished chunk meshes to the GPU
+void UploadChunkMeshes() { UploadReadyChunkMeshes(MESH_UPLOADS_PER_FRAME); }
+
+static Vector3 DrawRegionPosition(const DrawRegionPage* page)
+{
+  const float regionVoxels = (float)(DRAW_REGION_SIZE * CHUNK_SIZE);
+  return (Vector3){(float)page->region.x * regionVoxels,
+                   (float)page->region.y * regionVoxels,
+                   (float)page->region.z * regionVoxels};
+}
+
+// Draws the draw regions in view, nearest first so closer terrain hides
+// what's behind it before it gets shaded. With cave culling only the chunks
+// reachable from the camera are drawn, in runs of neighboring ranges,
+// otherwise each page in the frustum is a call
 void DrawChunks(void)
 {
-  MapIterator it = MapIteratorCreate(loadedChunks);
-  ChunkKey key;
-  Chunk* chunk;
-  while (MapIteratorNext(&it, &key, &chunk))
+  const Camera3D camera = GetPlayerCamera();
+  const Frustum frustum = FrustumFromCamera(
+    camera, (float)GetScreenWidth() / (float)GetScreenHeight());
+  const Frustum* cullFrustum = GetFrustumCulling() ? &frustum : NULL;
+
+  BeginChunkRendering(GetDrawWireFrame());
+  if (GetCaveCulling())
+  {
+    int visibleCount;
+    Chunk* const* visibleList = BuildVisibleChunkList(
+      loadedChunks, cullFrustum, camera.position, &visibleCount);
+    int runCount;
+    const DrawRegionRun* runList =
+      BuildRegionRunList(visibleList, visibleCount, &runCount);
+    for (int i = 0; i < runCount; i++)
+    {
+      DrawRegionGpuBuffer(&runList[i].page->buffer, runList[i].firstQuad,
+                          runList[i].quadCount,
+                          DrawRegionPosition(runList[i].page));
+    }
+  }
+  else
   {
-    if (chunk && chunk->model.meshCount > 0)
+    int pageCount;
+    DrawRegionPage* const* pageList =
+      BuildRegionDrawList(cullFrustum, camera.position, &pageCount);
+    for (int i = 0; i < pageCount; i++)
     {
-      const Vector3 chunkPos = {(float)chunk->position.x * CHUNK_SIZE,
-                                (float)chunk->position.y * CHUNK_SIZE,
-                                (float)chunk->position.z * CHUNK_SIZE};
-      if (GetDrawWireFrame())
-        DrawModelWires(chunk->model, chunkPos, 1.0f, WHITE);
-      else
-        DrawModel(chunk->model, chunkPos, 1.0f, WHITE);
-      if (GetDrawChunkBorders())
-      {
-        const BoundingBox bounds = {
-          chunkPos,
-          Vector3Add(chunkPos, (Vector3){CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE})};
-        DrawBoundingBox(bounds, RED);
-      }
+      DrawRegionGpuBuffer(&pageList[i]->buffer, 0,
+                          DrawRegionPageQuads(pageList[i]),
+                          DrawRegionPosition(pageList[i]));
     }
   }
+  EndChunkRendering();
+
+  if (!GetDrawChunkBorders()) return;
+
+  // Borders are per chunk, so they're culled on their own
+  int drawCount;
+  Chunk* const* drawList = BuildChunkDrawList(loadedChunks, cullFrustum,
+                                              camera.position, &drawCount);
+  for (int i = 0; i < drawCount; i++)
+  {
+    const Chunk* chunk = drawList[i];
+    const Vector3 chunkPos = {(float)chunk->position.x * CHUNK_SIZE,
+                              (float)chunk->position.y * CHUNK_SIZE,
+                              (float)chunk->position.z * CHUNK_SIZE};
+    const BoundingBox bounds = {
+      chunkPos,
+      Vector3Add(chunkPos, (Vector3){CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE})};
+    DrawBoundingBox(bounds, RED);
+  }
 }
 
 static void UpdateNeighboringChunkMeshes(const int chunkX, const int chunkY,
@@ -236,23 +530,93 @@ static void UpdateNeighboringChunkMeshes(const int chunkX, const int chunkY,
     const int neighborY = chunkY + offsets[i][1];
     const int neighborZ = chunkZ + offsets[i][2];
     Chunk* neighborChunk = GetChunkFromMap(neighborX, neighborY, neighborZ);
-    if (neighborChunk) { neighborChunk->needsMeshing = true; }
+    if (neighborChunk) { MarkChunkMeshDirty(neighborChunk); }
+  }
+}
+
+// Neighbors are remeshed with the chunk since their seams with it depend on
+// its level
+static void UpdateChunkLod(Chunk* chunk, const Vector3I center,
+                           const int lodDistance)
+{
+  const int level = ChunkLodLevel(chunk->position, center, lodDistance);
+  if (level == chunk->lodLevel) return;
+
+  // Empty chunks have no mesh or seams to redo
+  if (ChunkVoxelsIsEmpty(&chunk->voxels))
+  {
+    chunk->lodLevel = (unsigned char)level;
+    return;
   }
+  MarkChunkMeshDirty(chunk);
+  UpdateNeighboringChunkMeshes(chunk->position.x, chunk->position.y,
+                               chunk->position.z);
 }
 
-static void CheckAndFreeEmptyChunk(Chunk* chunk)
+// A step of n chunks brings a chunk at most n closer to or farther from the
+// center, so only chunks within n of a ring around the old center can change
+// level. Every loaded chunk is in the streaming offset table, so those are
+// the shells of it around each ring, widened by how far the table's center
+// is from the old one. Returns false if there's no table to walk
+static bool UpdateChunkLodsNearRings(const Vector3I oldCenter,
+                                     const Vector3I center,
+                                     const int lodDistance)
 {
-  if (!chunk->voxels) return;
+  int offsetCount;
+  const Vector3I* offsets =
+    GetStreamingOffsets(streamingDistance, &offsetCount);
+  if (!offsets) return false;
+
+  const float reach =
+    StepLength(oldCenter, center) + StepLength(streamingCenter, oldCenter);
+  const float tableDistance = (float)streamingDistance;
+  int visitedEnd = 0;
+  float ring = (float)lodDistance;
+  for (int level = 0; level < MAX_CHUNK_LOD; level++, ring *= 2.0f)
+  {
+    if (ring - reach >= tableDistance) break;
 
-  const size_t totalVoxels = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
-  for (size_t i = 0; i < totalVoxels; i++)
+    // Chunks up to ring - reach out stay inside the ring from either center
+    const float inner = ring - reach;
+    const float outer = ring + reach;
+    int start = inner < 0.0f
+                  ? 0
+                  : GetStreamingShellStart(streamingDistance, (int)inner);
+    const int end =
+      outer >= tableDistance
+        ? offsetCount
+        : GetStreamingShellStart(streamingDistance, (int)outer);
+    if (start < visitedEnd) start = visitedEnd;
+    for (int i = start; i < end; i++)
+    {
+      Chunk* chunk = GetChunkFromMap(streamingCenter.x + offsets[i].x,
+                                     streamingCenter.y + offsets[i].y,
+                                     streamingCenter.z + offsets[i].z);
+      if (chunk) UpdateChunkLod(chunk, center, lodDistance);
+    }
+    if (end > visitedEnd) visitedEnd = end;
+  }
+  return true;
+}
+
+// Only runs when the player crosses into another chunk or the distance
+// changes. A step only looks at the chunks near the rings where the level
+// goes up, a new distance or a world that isn't streaming looks at them all
+void UpdateChunkLods(const Vector3I center, const int lodDistance)
+{
+  const Vector3I oldCenter = lastLodCenter;
+  const bool sameDistance = lodDistance == lastLodDistance;
+  lastLodCenter = center;
+  lastLodDistance = lodDistance;
+  if (!SetChunkMeshLod(center, lodDistance) || !loadedChunks) return;
+  if (sameDistance && streamingActive &&
+      UpdateChunkLodsNearRings(oldCenter, center, lodDistance))
   {
-    if (chunk->voxels[i].type != AIR) return;
+    return;
   }
 
-  if (chunk->model.meshCount > 0) { REMOVE_CHUNK_MODEL(chunk); }
-  TraceLog(LOG_INFO, "Freeing empty chunk at (%d, %d, %d)", chunk->position.x,
-           chunk->position.y, chunk->position.z);
-  free(chunk->voxels);
-  chunk->voxels = NULL;
+  ChunkHashMapIterator it = ChunkHashMapIteratorCreate(loadedChunks);
+  Chunk* chunk;
+  while (ChunkHashMapIteratorNext(&it, NULL, &chunk))
+    UpdateChunkLod(chunk, center, lodDistance);
 }
@@ -28,13 +28,30 @@
 
 #include "dataTypes.h"
 
+typedef struct VoxelMemoryStats
+{
+  int chunkCount;       // Loaded chunks
+  int storedChunkCount; // Loaded chunks that hold any voxel memory
+  int solidChunkCount;  // Loaded chunks of a single type other than AIR
+  size_t bytes;         // Voxel memory of every loaded chunk
+} VoxelMemoryStats;
+
 // Main API
 void PlaceVoxel(Vector3 position, VoxelType type);
 void BreakVoxel(Vector3 position);
 Voxel GetVoxel(Vector3 position);
+// Same, at integer voxel coordinates, see voxelEdits for reading whole regions
+Voxel GetVoxelAt(Vector3I position);
 
 void LoadChunksInRenderDistance();
+void LoadChunksAround(Vector3I playerChunk, int drawDistance, float budgetMs);
+// Remeshes the chunks whose level of detail changes when it is measured from
+// center, 0 for full resolution everywhere (see ChunkLodLevel)
+void UpdateChunkLods(Vector3I center, int lodDistance);
+void UploadChunkMeshes();
 void DrawChunks();
+void RemeshWorld();
 void DestroyWorld();
+VoxelMemoryStats GetVoxelMemoryStats();
 
 #endif // WORLD_H
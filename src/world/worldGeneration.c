@@ -24,12 +24,55 @@
 *******************************************************************************/
 
 #include "worldGeneration.h"
-#include <math.h>
-#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include "chunkVoxels.h"
 #include "dataTypes.h"
+#include "heightmapCache.h"
+#include "noise.h"
 #include "settings.h"
 
-static float PerlinNoise2D(float x, float y);
+#define TERRAIN_BASE_HEIGHT 16
+#define TERRAIN_HEIGHT_RANGE 16 // Max distance from the base height
+
+static const FbmNoise terrainNoise = {
+  .seed = WORLD_SEED,
+  .octaves = 5,
+  .frequency = 1.0f / 128.0f,
+  .lacunarity = 2.0f,
+  .persistence = 0.5f,
+};
+
+// Fills a column's surface heights from fBm noise, a whole row per call
+static void FillHeightmap(const int chunkX, const int chunkZ, Heightmap* out)
+{
+  out->minHeight = SHRT_MAX;
+  out->maxHeight = SHRT_MIN;
+  for (int z = 0; z < CHUNK_SIZE; z++)
+  {
+    float noise[NOISE_ROW_WIDTH];
+    NoiseFbm2DRow(&terrainNoise, chunkX * CHUNK_SIZE, chunkZ * CHUNK_SIZE + z,
+                  noise);
+    for (int x = 0; x < CHUNK_SIZE; x++)
+    {
+      const short height =
+        (short)((int)(noise[x] * TERRAIN_HEIGHT_RANGE) + TERRAIN_BASE_HEIGHT);
+      out->heights[z][x] = height;
+      if (height < out->minHeight) out->minHeight = height;
+      if (height > out->maxHeight) out->maxHeight = height;
+    }
+  }
+}
+
+// The single type filling a chunk if the heightmap alone decides it, else -1
+static int ClassifyChunk(const int chunkY, const Heightmap* heightmap)
+{
+  const int bottom = chunkY * CHUNK_SIZE;
+  const int top = bottom + CHUNK_SIZE - 1;
+  if (top < 0 || bottom > heightmap->maxHeight) return AIR;
+  if (bottom >= 0 && top < heightmap->minHeight - 1) return STONE;
+  return -1;
+}
 
 void GenerateChunk(Chunk* chunk)
 {
@@ -39,60 +82,57 @@ void GenerateChunk(Chunk* chunk)
     return;
   }
 
-  // Allocate a temporary buffer for voxel data.
-  const size_t totalVoxels = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
-  Voxel* tempVoxels = calloc(totalVoxels, sizeof(Voxel));
-  if (!tempVoxels)
+  const Vector3I position = chunk->position;
+
+  // Chunks requested by the world share their column's cached heightmap
+  Heightmap localHeightmap;
+  const Heightmap* heightmap;
+  if (chunk->column)
+    heightmap = HeightmapCacheResolve(chunk->column, FillHeightmap);
+  else
+  {
+    FillHeightmap(position.x, position.z, &localHeightmap);
+    heightmap = &localHeightmap;
+  }
+
+  // Entirely above or below the surface, no voxels to look at
+  const int uniformType = ClassifyChunk(position.y, heightmap);
+  if (uniformType >= 0)
   {
-    TraceLog(LOG_ERROR, "Failed to allocate temporary voxel buffer for chunk");
+    ChunkVoxelsFree(&chunk->voxels);
+    chunk->voxels.uniformType = (unsigned char)uniformType;
     return;
   }
 
-  bool nonAirFound = false;
+  // Voxel types are generated in full, then packed into the chunk's palette
+  unsigned char types[CHUNK_VOLUME];
 
-  for (int x = 0; x < CHUNK_SIZE; x++)
+  // Rows run along x to match the voxel layout
+  for (int z = 0; z < CHUNK_SIZE; z++)
   {
-    for (int z = 0; z < CHUNK_SIZE; z++)
+    for (int y = 0; y < CHUNK_SIZE; y++)
     {
-      // Use Perlin noise to generate a smooth height map.
-      const float noise =
-        PerlinNoise2D((float)(chunk->position.x * CHUNK_SIZE + x) * 0.1f,
-                      (float)(chunk->position.z * CHUNK_SIZE + z) * 0.1f);
-      const int height = (int)(noise * 10.0f) + 10;
-
-      for (int y = 0; y < CHUNK_SIZE; y++)
+      const int globalY = position.y * CHUNK_SIZE + y;
+      unsigned char* row = &types[VOXEL_INDEX(0, y, z)];
+      if (globalY < 0)
       {
-        const int globalY = chunk->position.y * CHUNK_SIZE + y;
-        VoxelType voxelType = AIR;
-
-        if (globalY >= 0)
-        {
-          if (globalY < height - 1)
-            voxelType = STONE;
-          else if (globalY < height)
-            voxelType = DIRT;
-          else if (globalY == height)
-            voxelType = GRASS;
-        }
+        memset(row, AIR, CHUNK_SIZE);
+        continue;
+      }
 
-        tempVoxels[VOXEL_INDEX(x, y, z)].type = voxelType;
-        if (voxelType != AIR) nonAirFound = true;
+      // Branch free so the compiler can do the whole row at once
+      for (int x = 0; x < CHUNK_SIZE; x++)
+      {
+        const int height = heightmap->heights[z][x];
+        row[x] = (unsigned char)(globalY < height - 1 ? STONE
+                                 : globalY < height   ? DIRT
+                                 : globalY == height  ? GRASS
+                                                      : AIR);
       }
     }
   }
 
-  // If any non-air voxel exists, move the temporary buffer into the chunk.
-  // Otherwise, free the buffer and leave chunk->voxels as NULL.
-  if (nonAirFound)
-    chunk->voxels = tempVoxels;
-  else
-  {
-    free(tempVoxels);
-    chunk->voxels = NULL;
-  }
-}
-
-static float PerlinNoise2D(const float x, const float y)
-{
-  return (sinf(x) + cosf(y)) * 0.5f;
+  // Chunks with nothing but AIR are left empty and take no memory
+  if (!ChunkVoxelsPack(&chunk->voxels, types))
+    TraceLog(LOG_ERROR, "Failed to store generated voxels for chunk");
 }
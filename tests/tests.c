@@ -0,0 +1,431 @@
+/*******************************************************************************
+* VoxelX
+*
+* The MIT License (MIT)
+* Copyright (c) 2025 Tyson Thigpen
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to
+* deal in the Software without restriction, including without limitation the
+* rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+* sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+// Headless checks of the CPU side bookkeeping behind chunk drawing. GPU
+// buffers are faked with plain memory below, so nothing here needs a window
+// and the checks run under ctest. Prints every failed check and exits with 1
+// if there was any.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "chunkBufferSizing.h"
+#include "chunkCulling.h"
+#include "chunkMeshGeneration.h"
+#include "chunkRenderer.h"
+#include "drawRegions.h"
+#include "rangeAllocator.h"
+#include "rlgl.h"
+
+#define FAKE_BUFFER_COUNT 64
+
+static int checkCount = 0;
+static int failureCount = 0;
+
+#define CHECK(condition) Check((condition), #condition, __FILE__, __LINE__)
+
+static void Check(const bool passed, const char* condition, const char* file,
+                  const int line)
+{
+  checkCount++;
+  if (passed) return;
+  failureCount++;
+  printf("%s:%d: check failed: %s\n", file, line, condition);
+}
+
+// Fake GPU buffers, vboId indexes their memory
+
+static uint32_t* fakeBuffers[FAKE_BUFFER_COUNT + 1];
+
+bool LoadRegionGpuBuffer(RegionGpuBuffer* buffer, const int quadCapacity)
+{
+  for (unsigned int id = 1; id <= FAKE_BUFFER_COUNT; id++)
+  {
+    if (fakeBuffers[id]) continue;
+    fakeBuffers[id] = calloc((size_t)quadCapacity * 4, sizeof(uint32_t));
+    if (!fakeBuffers[id]) return false;
+    *buffer = (RegionGpuBuffer){id, id, quadCapacity};
+    return true;
+  }
+  return false;
+}
+
+void UnloadRegionGpuBuffer(RegionGpuBuffer* buffer)
+{
+  free(fakeBuffers[buffer->vboId]);
+  fakeBuffers[buffer->vboId] = NULL;
+  *buffer = (RegionGpuBuffer){0};
+}
+
+void UpdateRegionGpuBuffer(const RegionGpuBuffer* buffer, const int firstQuad,
+                           const uint32_t* vertices, const int quadCount)
+{
+  if (quadCount <= 0) return;
+  CHECK(firstQuad >= 0 && firstQuad + quadCount <= buffer->quadCapacity);
+  uint32_t* quads = &fakeBuffers[buffer->vboId][firstQuad * 4];
+  if (vertices)
+    memcpy(quads, vertices, (size_t)quadCount * 4 * sizeof(uint32_t));
+  else
+    memset(quads, 0, (size_t)quadCount * 4 * sizeof(uint32_t));
+}
+
+static int LoadedFakeBuffers(void)
+{
+  int count = 0;
+  for (int id = 1; id <= FAKE_BUFFER_COUNT; id++)
+    count += fakeBuffers[id] != NULL;
+  return count;
+}
+
+// True if quadCount quads of the page from firstQuad on are all zero
+static bool QuadsAreZero(const DrawRegionPage* page, const int firstQuad,
+                         const int quadCount)
+{
+  const uint32_t* quads = &fakeBuffers[page->buffer.vboId][firstQuad * 4];
+  for (int i = 0; i < quadCount * 4; i++)
+  {
+    if (quads[i]) return false;
+  }
+  return true;
+}
+
+// Frustum culling
+
+// Bit i set for every frustum plane the box lies entirely outside of
+static int PlanesOutside(const Frustum* frustum, const BoundingBox box)
+{
+  int planes = 0;
+  for (int i = 0; i < 6; i++)
+  {
+    Frustum single;
+    for (int j = 0; j < 6; j++)
+      single.planes[j] = frustum->planes[i];
+    if (!FrustumIntersectsBox(&single, box)) planes |= 1 << i;
+  }
+  return planes;
+}
+
+// Box of the given half size around a center
+static BoundingBox BoxAround(const Vector3 center, const float half)
+{
+  return (BoundingBox){{center.x - half, center.y - half, center.z - half},
+                       {center.x + half, center.y + half, center.z + half}};
+}
+
+static void TestFrustumCulling(void)
+{
+  // Looking down -z, 10 units out the view is about 5.8 units to each side
+  const Camera3D camera = {{0.0f, 0.0f, 0.0f},
+                           {0.0f, 0.0f, -10.0f},
+                           {0.0f, 1.0f, 0.0f},
+                           60.0f,
+                           CAMERA_PERSPECTIVE};
+  const Frustum frustum = FrustumFromCamera(camera, 1.0f);
+
+  // In front is kept
+  const BoundingBox front = BoxAround((Vector3){0.0f, 0.0f, -10.0f}, 1.0f);
+  CHECK(FrustumIntersectsBox(&frustum, front));
+  CHECK(PlanesOutside(&frustum, front) == 0);
+
+  // Behind the camera is culled, it's behind the near plane
+  const BoundingBox behind = BoxAround((Vector3){0.0f, 0.0f, 10.0f}, 1.0f);
+  CHECK(!FrustumIntersectsBox(&frustum, behind));
+  CHECK(PlanesOutside(&frustum, behind) & 1 << 4);
+
+  // Outside of each side plane, and past the far one, only that plane culls
+  const Vector3 outside[5] = {{-20.0f, 0.0f, -10.0f},
+                              {20.0f, 0.0f, -10.0f},
+                              {0.0f, -20.0f, -10.0f},
+                              {0.0f, 20.0f, -10.0f},
+                              {0.0f, 0.0f, -RL_CULL_DISTANCE_FAR - 10.0f}};
+  const int outsidePlanes[5] = {0, 1, 2, 3, 5};
+  for (int i = 0; i < 5; i++)
+  {
+    const BoundingBox box = BoxAround(outside[i], 1.0f);
+    CHECK(!FrustumIntersectsBox(&frustum, box));
+    CHECK(PlanesOutside(&frustum, box) == 1 << outsidePlanes[i]);
+  }
+
+  // Straddling a plane is kept, as is a box around the camera
+  const Vector3 straddling[5] = {{-6.0f, 0.0f, -10.0f},
+                                 {6.0f, 0.0f, -10.0f},
+                                 {0.0f, -6.0f, -10.0f},
+                                 {0.0f, 6.0f, -10.0f},
+                                 {0.0f, 0.0f, -RL_CULL_DISTANCE_FAR}};
+  for (int i = 0; i < 5; i++)
+  {
+    // The far plane is only good to a few units with a near plane this close
+    const float half = i == 4 ? 20.0f : 1.0f;
+    CHECK(FrustumIntersectsBox(&frustum, BoxAround(straddling[i], half)));
+  }
+  CHECK(FrustumIntersectsBox(&frustum, BoxAround(camera.position, 1.0f)));
+  CHECK(FrustumIntersectsBox(&frustum, BoxAround(camera.position, 5000.0f)));
+
+  // A wider aspect ratio widens the view sideways only
+  const Frustum wide = FrustumFromCamera(camera, 2.0f);
+  const BoundingBox side = BoxAround((Vector3){9.0f, 0.0f, -10.0f}, 1.0f);
+  const BoundingBox above = BoxAround((Vector3){0.0f, 9.0f, -10.0f}, 1.0f);
+  CHECK(!FrustumIntersectsBox(&frustum, side));
+  CHECK(FrustumIntersectsBox(&wide, side));
+  CHECK(!FrustumIntersectsBox(&wide, above));
+}
+
+// Range allocator
+
+static void TestRangeAllocator(void)
+{
+  RangeAllocator* allocator = RangeAllocatorCreate(100);
+  CHECK(allocator != NULL);
+  if (!allocator) return;
+
+  // Allocations pack towards the start
+  CHECK(RangeAllocate(allocator, 10) == 0);
+  CHECK(RangeAllocate(allocator, 20) == 10);
+  CHECK(RangeAllocate(allocator, 30) == 30);
+  CHECK(RangeAllocatorEnd(allocator) == 60);
+  CHECK(RangeAllocatorUsed(allocator) == 60);
+  CHECK(RangeAllocate(allocator, 0) == -1);
+
+  // A freed hole is reused by the lowest allocation that fits it
+  RangeRelease(allocator, 10, 20);
+  CHECK(RangeAllocatorUsed(allocator) == 40);
+  CHECK(RangeAllocate(allocator, 25) == 60);
+  CHECK(RangeAllocate(allocator, 15) == 10);
+  CHECK(RangeAllocatorEnd(allocator) == 85);
+
+  // Exhaustion, the 5 left at 25 and the 15 at the end don't add up
+  CHECK(RangeAllocate(allocator, 16) == -1);
+  CHECK(RangeAllocate(allocator, 15) == 85);
+  CHECK(RangeAllocate(allocator, 5) == 25);
+  CHECK(RangeAllocatorUsed(allocator) == 100);
+  CHECK(RangeAllocate(allocator, 1) == -1);
+
+  // Releasing out of order merges the free ranges back into one
+  RangeRelease(allocator, 60, 25);
+  RangeRelease(allocator, 0, 10);
+  RangeRelease(allocator, 25, 5);
+  RangeRelease(allocator, 85, 15);
+  CHECK(RangeAllocatorEnd(allocator) == 60);
+  RangeRelease(allocator, 30, 30);
+  RangeRelease(allocator, 10, 15);
+  CHECK(RangeAllocatorUsed(allocator) == 0);
+  CHECK(RangeAllocatorEnd(allocator) == 0);
+  CHECK(RangeAllocate(allocator, 100) == 0);
+  RangeRelease(allocator, 0, 100);
+
+  // Many small holes grow the free list past its first capacity
+  for (int i = 0; i < 50; i++)
+    CHECK(RangeAllocate(allocator, 2) == i * 2);
+  for (int i = 0; i < 50; i += 2)
+    RangeRelease(allocator, i * 2, 2);
+  CHECK(RangeAllocatorUsed(allocator) == 50);
+  CHECK(RangeAllocate(allocator, 3) == -1);
+  for (int i = 1; i < 50; i += 2)
+    RangeRelease(allocator, i * 2, 2);
+  CHECK(RangeAllocate(allocator, 100) == 0);
+
+  RangeAllocatorDestroy(allocator);
+}
+
+// Chunk buffer sizing
+
+static void TestChunkBufferSizing(void)
+{
+  // Classes step between powers of two and the halfway point above them
+  CHECK(ChunkBufferCapacity(1) == MIN_CHUNK_BUFFER_QUADS);
+  CHECK(ChunkBufferCapacity(64) == 64);
+  CHECK(ChunkBufferCapacity(65) == 96);
+  CHECK(ChunkBufferCapacity(96) == 96);
+  CHECK(ChunkBufferCapacity(97) == 128);
+  CHECK(ChunkBufferCapacity(129) == 192);
+  CHECK(ChunkBufferCapacity(193) == 256);
+  CHECK(ChunkBufferCapacity(12288) == 12288);
+  CHECK(ChunkBufferCapacity(12289) == MAX_CHUNK_QUADS);
+  CHECK(ChunkBufferCapacity(MAX_CHUNK_QUADS) == MAX_CHUNK_QUADS);
+
+  // Nothing to upload, or too much
+  CHECK(ChunkBufferCapacity(0) == 0);
+  CHECK(ChunkBufferCapacity(-1) == 0);
+  CHECK(ChunkBufferCapacity(MAX_CHUNK_QUADS + 1) == 0);
+
+  // Every mesh fits its class, which never wastes more than a third past the
+  // smallest buffer, and a fresh buffer can always be updated in place
+  int previous = 0;
+  bool fits = true;
+  bool tight = true;
+  bool ordered = true;
+  bool reusable = true;
+  for (int quadCount = 1; quadCount <= MAX_CHUNK_QUADS; quadCount++)
+  {
+    const int capacity = ChunkBufferCapacity(quadCount);
+    fits = fits && capacity >= quadCount;
+    tight = tight && (capacity == MIN_CHUNK_BUFFER_QUADS ||
+                      capacity * 2 < quadCount * 3);
+    ordered = ordered && capacity >= previous;
+    reusable = reusable && CanReuseChunkBuffer(capacity, quadCount);
+    previous = capacity;
+  }
+  CHECK(fits);
+  CHECK(tight);
+  CHECK(ordered);
+  CHECK(reusable);
+
+  // Meshes that outgrew the buffer need a new one
+  CHECK(!CanReuseChunkBuffer(64, 65));
+  CHECK(!CanReuseChunkBuffer(256, 257));
+  CHECK(!CanReuseChunkBuffer(64, 0));
+
+  // Shrinking keeps the buffer until the mesh's own class is a quarter of it
+  CHECK(CanReuseChunkBuffer(256, 65));
+  CHECK(!CanReuseChunkBuffer(256, 64));
+  CHECK(CanReuseChunkBuffer(384, 97));
+  CHECK(!CanReuseChunkBuffer(384, 96));
+  CHECK(!CanReuseChunkBuffer(MAX_CHUNK_QUADS, 1));
+}
+
+// Draw region page packing
+
+// Uploads quadCount quads of a single repeated vertex
+static bool UploadTestMesh(ChunkGpuMesh* mesh, const Vector3I chunkPosition,
+                           const int quadCount)
+{
+  uint32_t* vertices = malloc((size_t)quadCount * 4 * sizeof(uint32_t));
+  if (!vertices) return false;
+  for (int i = 0; i < quadCount * 4; i++)
+    vertices[i] = PACK_CHUNK_VERTEX(1, 2, 3, 0, 1);
+  const bool uploaded =
+    UploadChunkToRegion(mesh, chunkPosition, vertices, quadCount);
+  free(vertices);
+  return uploaded;
+}
+
+static void TestDrawRegionPacking(void)
+{
+  static Chunk chunks[8];
+  for (int i = 0; i < 8; i++)
+    chunks[i].position = (Vector3I){i % 4, 0, 0};
+
+  // Chunks of a region share a page, each in a range of its capacity class
+  CHECK(UploadTestMesh(&chunks[0].mesh, chunks[0].position, 10));
+  CHECK(UploadTestMesh(&chunks[1].mesh, chunks[1].position, 10));
+  CHECK(UploadTestMesh(&chunks[2].mesh, chunks[2].position, 10));
+  DrawRegionPage* page = chunks[0].mesh.page;
+  CHECK(page != NULL);
+  if (!page) return;
+  CHECK(chunks[1].mesh.page == page && chunks[2].mesh.page == page);
+  CHECK(chunks[1].mesh.firstQuad == 64 && chunks[2].mesh.firstQuad == 128);
+  CHECK(page->chunkCount == 3);
+  CHECK(DrawRegionPageQuads(page) == 192);
+
+  // Vertices are moved from chunk to region coordinates
+  const uint32_t* quads = fakeBuffers[page->buffer.vboId];
+  CHECK(quads[0] == PACK_CHUNK_VERTEX(1, 2, 3, 0, 1));
+  CHECK(quads[64 * 4] == PACK_CHUNK_VERTEX(1 + CHUNK_SIZE, 2, 3, 0, 1));
+  CHECK(QuadsAreZero(page, 10, 54));
+
+  // Ranges next to each other are drawn as one run, gaps split them
+  Chunk* visible[3] = {&chunks[2], &chunks[0], &chunks[1]};
+  int runCount = 0;
+  const DrawRegionRun* runs = BuildRegionRunList(visible, 3, &runCount);
+  CHECK(runCount == 1);
+  CHECK(runs[0].page == page && runs[0].firstQuad == 0);
+  CHECK(runs[0].quadCount == 128 + 10);
+  visible[2] = &chunks[3];
+  runs = BuildRegionRunList(visible, 2, &runCount);
+  CHECK(runCount == 2);
+
+  // Remeshing within the capacity class stays in place and zeroes the rest
+  CHECK(UploadTestMesh(&chunks[1].mesh, chunks[1].position, 40));
+  CHECK(chunks[1].mesh.firstQuad == 64 && chunks[1].mesh.quadCount == 40);
+  CHECK(UploadTestMesh(&chunks[1].mesh, chunks[1].position, 20));
+  CHECK(chunks[1].mesh.firstQuad == 64);
+  CHECK(QuadsAreZero(page, 64 + 20, 44));
+
+  // Removing a chunk zeroes its range, the page ends at its last range
+  RemoveChunkFromRegion(&chunks[1].mesh);
+  CHECK(chunks[1].mesh.page == NULL);
+  CHECK(QuadsAreZero(page, 64, 64));
+  CHECK(DrawRegionPageQuads(page) == 192);
+  RemoveChunkFromRegion(&chunks[2].mesh);
+  CHECK(DrawRegionPageQuads(page) == 64);
+
+  // Growing out of its range moves the chunk to the lowest free one
+  CHECK(UploadTestMesh(&chunks[0].mesh, chunks[0].position, 100));
+  CHECK(chunks[0].mesh.page == page && chunks[0].mesh.firstQuad == 64);
+  CHECK(chunks[0].mesh.quadCapacity == 128);
+  CHECK(QuadsAreZero(page, 0, 64));
+
+  // Another region gets its own page
+  const Vector3I farChunk = {DRAW_REGION_SIZE, 0, 0};
+  CHECK(UploadTestMesh(&chunks[4].mesh, farChunk, 10));
+  CHECK(chunks[4].mesh.page && chunks[4].mesh.page != page);
+  CHECK(chunks[4].mesh.page->region.x == 1);
+
+  // A full page makes the region add another, and meshes larger than a page
+  // get one of their own
+  CHECK(DRAW_REGION_PAGE_QUADS / ChunkBufferCapacity(2000) == 4);
+  ChunkGpuMesh large[5] = {0};
+  for (int i = 0; i < 4; i++)
+    CHECK(UploadTestMesh(&large[i], farChunk, 2000));
+  CHECK(large[2].page == chunks[4].mesh.page);
+  CHECK(large[3].page && large[3].page != large[2].page);
+  CHECK(UploadTestMesh(&large[4], farChunk, 2000));
+  CHECK(large[4].page == large[3].page);
+  ChunkGpuMesh huge = {0};
+  CHECK(UploadTestMesh(&huge, farChunk, DRAW_REGION_PAGE_QUADS + 1));
+  CHECK(huge.page && huge.page->buffer.quadCapacity > DRAW_REGION_PAGE_QUADS);
+  CHECK(huge.page != large[3].page);
+  CHECK(GetDrawRegionStats().pageCount == 4);
+
+  // Meshes too large to upload leave the chunk without one
+  CHECK(!UploadTestMesh(&huge, farChunk, MAX_CHUNK_QUADS + 1));
+  CHECK(huge.page == NULL);
+
+  // Emptied pages are kept as spares and reused, then freed for good
+  for (int i = 0; i < 5; i++)
+    RemoveChunkFromRegion(&large[i]);
+  RemoveChunkFromRegion(&chunks[4].mesh);
+  RemoveChunkFromRegion(&chunks[0].mesh);
+  const DrawRegionStats stats = GetDrawRegionStats();
+  CHECK(stats.pageCount == 0 && stats.quadCapacity == 0);
+  CHECK(stats.spareCount == 3);
+  CHECK(UploadTestMesh(&chunks[0].mesh, chunks[0].position, 10));
+  CHECK(GetDrawRegionStats().spareCount == 2);
+  CHECK(chunks[0].mesh.firstQuad == 0 && DrawRegionPageQuads(page) != 0);
+  RemoveChunkFromRegion(&chunks[0].mesh);
+  FreeDrawRegions();
+  CHECK(LoadedFakeBuffers() == 0);
+}
+
+int main(void)
+{
+  TestFrustumCulling();
+  TestRangeAllocator();
+  TestChunkBufferSizing();
+  TestDrawRegionPacking();
+
+  printf("%d checks, %d failed\n", checkCount, failureCount);
+  return failureCount > 0;
+}